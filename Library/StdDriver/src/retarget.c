@@ -28,6 +28,22 @@
 #endif
 # define BUF_SIZE     512
 
+#if defined(DEBUG_TX_IRQ)
+/* Interrupt-driven TX ring : overflow policy when ring is full */
+#define DEBUG_TX_POLICY_BLOCK       0   /* wait for THRE interrupt to make room */
+#define DEBUG_TX_POLICY_DROP_NEW    1   /* discard the new char */
+#define DEBUG_TX_POLICY_DROP_OLD    2   /* discard the oldest char in ring */
+
+#ifndef DEBUG_TX_POLICY
+    #define DEBUG_TX_POLICY         DEBUG_TX_POLICY_BLOCK
+#endif
+
+#ifndef DEBUG_TX_BUF_SIZE
+    #define DEBUG_TX_BUF_SIZE       512 /* must be power of 2 */
+#endif
+#define DEBUG_TX_BUF_MASK           (DEBUG_TX_BUF_SIZE - 1)
+#endif
+
 
 /*---------------------------------------------------------------------------------------------------------*/
 /* Global variables                                                                                        */
@@ -90,6 +106,28 @@ char GetChar(void);
 void SendChar_ToUART(int ch);
 void SendChar(int ch);
 static volatile int32_t g_ICE_Conneced = 1;
+
+#if defined(DEBUG_TX_IRQ)
+static volatile uint8_t  g_au8DebugTxBuf[DEBUG_TX_BUF_SIZE];
+static volatile uint32_t g_u32DebugTxHead = 0;     /* free running, written by SendChar_ToUART */
+static volatile uint32_t g_u32DebugTxTail = 0;     /* free running, written by DebugTx_IRQHandler */
+static volatile uint32_t g_u32DebugTxDropCnt = 0;
+static volatile uint32_t g_u32DebugTxBlockCnt = 0;
+static volatile uint32_t g_u32DebugTxMaxUsed = 0;
+static volatile uint32_t g_u32DebugTxLimit = 0;    /* drain stop while paused */
+static volatile uint8_t  g_u8DebugTxPaused = 0;
+static void (*volatile g_pfnDebugTxDrained)(void) = 0;
+
+void DebugTx_IRQHandler(void);
+uint32_t DebugTx_GetDropCnt(void);
+uint32_t DebugTx_GetBlockCnt(void);
+uint32_t DebugTx_GetMaxUsed(void);
+void DebugTx_ClearStats(void);
+void DebugTx_Flush(void);
+int32_t DebugTx_WriteRaw(const uint8_t *pu8Data, uint32_t u32Len);
+int32_t DebugTx_Pause(void (*pfnDrained)(void));
+void DebugTx_Resume(void);
+#endif
 enum { r0, r1, r2, r3, r12, lr, pc, psr};
 
 
@@ -260,7 +298,273 @@ uint32_t ProcessHardFault(uint32_t lr, uint32_t msp, uint32_t psp)
  *
  * @details  Send a target char to UART debug port .
  */
-#ifndef NONBLOCK_PRINTF
+#if defined(DEBUG_TX_IRQ)
+
+/**
+ * @brief    Move chars from TX ring into UART FIFO
+ *
+ * @param    None
+ *
+ * @returns  None
+ *
+ * @details  Call from the debug port UART IRQ handler when THREINT is set.
+ *           THRE interrupt is disabled once the ring is empty, or once the
+ *           pause limit is reached (drained callback of DebugTx_Pause run here).
+ */
+void DebugTx_IRQHandler(void)
+{
+    uint32_t u32Tail = g_u32DebugTxTail;
+    uint32_t u32End = g_u8DebugTxPaused ? g_u32DebugTxLimit : g_u32DebugTxHead;
+    void (*pfnDrained)(void);
+
+    while ((u32Tail != u32End) && ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) == 0U))
+    {
+        DEBUG_PORT->DAT = g_au8DebugTxBuf[u32Tail & DEBUG_TX_BUF_MASK];
+        u32Tail++;
+    }
+
+    g_u32DebugTxTail = u32Tail;
+
+    if (u32Tail == u32End)
+    {
+        DEBUG_PORT->INTEN &= ~UART_INTEN_THREIEN_Msk;
+
+        pfnDrained = g_pfnDebugTxDrained;
+        if (g_u8DebugTxPaused && (pfnDrained != 0))
+        {
+            g_pfnDebugTxDrained = 0;
+            pfnDrained();
+        }
+    }
+}
+
+/**
+ * @brief    Stop the ring at its current head, for another writer of the debug port
+ *
+ * @param[in] pfnDrained  Called from DebugTx_IRQHandler once the chars queued before the pause are
+ *                        in the UART FIFO, not called if return 1
+ *
+ * @retval   1: Nothing left before the pause point, the other writer may start now
+ * @retval   0: Wait for pfnDrained
+ *
+ * @details  Chars put while paused stay in the ring until DebugTx_Resume, so a PDMA block written
+ *           to the same port is never interleaved with printf output. Call with interrupts masked.
+ */
+int32_t DebugTx_Pause(void (*pfnDrained)(void))
+{
+    g_u32DebugTxLimit = g_u32DebugTxHead;
+    g_u8DebugTxPaused = 1;
+
+    if (g_u32DebugTxTail == g_u32DebugTxLimit)
+    {
+        g_pfnDebugTxDrained = 0;
+        DEBUG_PORT->INTEN &= ~UART_INTEN_THREIEN_Msk;
+        return 1;
+    }
+
+    g_pfnDebugTxDrained = pfnDrained;
+    DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+    return 0;
+}
+
+/**
+ * @brief    End of DebugTx_Pause, chars put meanwhile start to drain
+ */
+void DebugTx_Resume(void)
+{
+    uint32_t u32PriMask;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    g_u8DebugTxPaused = 0;
+    g_pfnDebugTxDrained = 0;
+
+    if (g_u32DebugTxTail != g_u32DebugTxHead)
+        DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+
+    __set_PRIMASK(u32PriMask);
+}
+
+/* Send oldest char by polling, used when THRE interrupt can not run */
+static void DebugTx_PollOne(void)
+{
+    /* paused at limit : the port belong to the other writer */
+    if (g_u8DebugTxPaused && (g_u32DebugTxTail == g_u32DebugTxLimit))
+        return;
+
+    while (DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) {}
+
+    DEBUG_PORT->DAT = g_au8DebugTxBuf[g_u32DebugTxTail & DEBUG_TX_BUF_MASK];
+    g_u32DebugTxTail++;
+}
+
+static void DebugTx_Put(uint8_t u8Ch)
+{
+    uint32_t u32PriMask;
+    uint32_t u32Used;
+
+    while (1)
+    {
+        u32PriMask = __get_PRIMASK();
+        __disable_irq();
+
+        u32Used = g_u32DebugTxHead - g_u32DebugTxTail;
+
+        if (u32Used < DEBUG_TX_BUF_SIZE)
+        {
+            g_au8DebugTxBuf[g_u32DebugTxHead & DEBUG_TX_BUF_MASK] = u8Ch;
+            g_u32DebugTxHead++;
+
+            if ((u32Used + 1U) > g_u32DebugTxMaxUsed)
+                g_u32DebugTxMaxUsed = u32Used + 1U;
+
+            if (g_u8DebugTxPaused == 0U)
+                DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+
+            __set_PRIMASK(u32PriMask);
+            return;
+        }
+
+        /* Ring full */
+#if (DEBUG_TX_POLICY == DEBUG_TX_POLICY_DROP_NEW)
+        g_u32DebugTxDropCnt++;
+        __set_PRIMASK(u32PriMask);
+        return;
+#elif (DEBUG_TX_POLICY == DEBUG_TX_POLICY_DROP_OLD)
+        g_u32DebugTxTail++;
+        g_u32DebugTxDropCnt++;
+        __set_PRIMASK(u32PriMask);
+#else
+        g_u32DebugTxBlockCnt++;
+
+        if (((u32PriMask != 0U) || ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0U)) && g_u8DebugTxPaused)
+        {
+            /* Paused for a PDMA block and resume can not run here: drop */
+            g_u32DebugTxDropCnt++;
+            __set_PRIMASK(u32PriMask);
+            return;
+        }
+        else if ((u32PriMask != 0U) || ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0U))
+        {
+            /* Interrupt masked or in handler mode: THRE interrupt may never come, drain by polling */
+            DebugTx_PollOne();
+            __set_PRIMASK(u32PriMask);
+        }
+        else
+        {
+            __set_PRIMASK(u32PriMask);
+
+            while ((g_u32DebugTxHead - g_u32DebugTxTail) >= DEBUG_TX_BUF_SIZE) {}
+        }
+#endif
+    }
+}
+
+/**
+ * @brief    Wait until TX ring and UART FIFO are empty
+ *
+ * @param    None
+ *
+ * @returns  None
+ */
+void DebugTx_Flush(void)
+{
+    while (g_u32DebugTxTail != g_u32DebugTxHead)
+    {
+        if ((__get_PRIMASK() != 0U) || ((SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0U))
+        {
+            /* Paused with resume blocked: leave the rest in ring */
+            if (g_u8DebugTxPaused && (g_u32DebugTxTail == g_u32DebugTxLimit))
+                return;
+
+            DebugTx_PollOne();
+        }
+    }
+
+    while ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXEMPTYF_Msk) == 0U) {}
+}
+
+uint32_t DebugTx_GetDropCnt(void)
+{
+    return g_u32DebugTxDropCnt;
+}
+
+uint32_t DebugTx_GetBlockCnt(void)
+{
+    return g_u32DebugTxBlockCnt;
+}
+
+uint32_t DebugTx_GetMaxUsed(void)
+{
+    return g_u32DebugTxMaxUsed;
+}
+
+void DebugTx_ClearStats(void)
+{
+    g_u32DebugTxDropCnt = 0;
+    g_u32DebugTxBlockCnt = 0;
+    g_u32DebugTxMaxUsed = 0;
+}
+
+/**
+ * @brief    Put a binary record into TX ring
+ *
+ * @param[in] pu8Data  Record data, no '\n' translation
+ * @param[in] u32Len   Record length
+ *
+ * @retval   0: Whole record queued
+ * @retval  -1: Not enough room, nothing queued
+ *
+ * @details  The record is copied in one critical section, so it is never
+ *           interleaved with chars from other contexts. Never block.
+ */
+int32_t DebugTx_WriteRaw(const uint8_t *pu8Data, uint32_t u32Len)
+{
+    uint32_t u32PriMask;
+    uint32_t u32Used;
+    uint32_t i;
+
+    u32PriMask = __get_PRIMASK();
+    __disable_irq();
+
+    u32Used = g_u32DebugTxHead - g_u32DebugTxTail;
+
+    if ((u32Used + u32Len) > DEBUG_TX_BUF_SIZE)
+    {
+        g_u32DebugTxDropCnt++;
+        __set_PRIMASK(u32PriMask);
+        return -1;
+    }
+
+    for (i = 0; i < u32Len; i++)
+    {
+        g_au8DebugTxBuf[g_u32DebugTxHead & DEBUG_TX_BUF_MASK] = pu8Data[i];
+        g_u32DebugTxHead++;
+    }
+
+    if ((u32Used + u32Len) > g_u32DebugTxMaxUsed)
+        g_u32DebugTxMaxUsed = u32Used + u32Len;
+
+    if ((u32Len > 0U) && (g_u8DebugTxPaused == 0U))
+        DEBUG_PORT->INTEN |= UART_INTEN_THREIEN_Msk;
+
+    __set_PRIMASK(u32PriMask);
+    return 0;
+}
+
+/* Interrupt-driven implement of send char */
+void SendChar_ToUART(int ch)
+{
+    if ((char)ch == '\n')
+    {
+        DebugTx_Put('\r');
+    }
+
+    DebugTx_Put((uint8_t)ch);
+}
+
+#elif !defined(NONBLOCK_PRINTF)
 void SendChar_ToUART(int ch)
 {
     while (DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk) {}
@@ -336,7 +640,7 @@ void SendChar_ToUART(int ch)
             break; // FIFO full
     } while (i32Tail != i32Head);
 }
-#endif /* else for NONBLOCK_PRINTF */
+#endif /* DEBUG_TX_IRQ / NONBLOCK_PRINTF */
 
 
 /**
@@ -490,6 +794,12 @@ int kbhit(void)
  */
 int IsDebugFifoEmpty(void)
 {
+#if defined(DEBUG_TX_IRQ)
+
+    if (g_u32DebugTxTail != g_u32DebugTxHead)
+        return 0;
+
+#endif
     return ((DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXEMPTYF_Msk) != 0U);
 }
 
@@ -544,6 +854,13 @@ int _write(int fd, char *ptr, int len)
 {
     int i = len;
 
+#if defined(DEBUG_TX_IRQ)
+
+    while (i--)
+        SendChar_ToUART(*ptr++);
+
+#else
+
     while (i--)
     {
         while (DEBUG_PORT->FIFOSTS & UART_FIFOSTS_TXFULL_Msk);
@@ -558,6 +875,8 @@ int _write(int fd, char *ptr, int len)
         DEBUG_PORT->DAT = *ptr++;
     }
 
+#endif
+
     return len;
 }
 
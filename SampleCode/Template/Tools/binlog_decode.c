@@ -0,0 +1,179 @@
+/*
+ * host side decoder for binlog.c record
+ *
+ * build : gcc -O2 -o binlog_decode binlog_decode.c
+ * usage : binlog_decode [capture.bin]     (stdin if no file)
+ *
+ * plain text between record is passed through unchanged
+ */
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <string.h>
+
+#include "../binlog_id.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define BINLOG_SYNC                             (0xA5U)
+#define BINLOG_MAX_ARGS                         (4U)
+#define BINLOG_MAX_RECORD                       (3U + 4U + (4U * BINLOG_MAX_ARGS) + 1U)
+
+#define BINLOG_FMT(name, fmt)                   fmt,
+#define BINLOG_NAME(name, fmt)                  #name,
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static const char * const s_fmt[] =
+{
+    BINLOG_ID_LIST(BINLOG_FMT)
+};
+
+static const char * const s_name[] =
+{
+    BINLOG_ID_LIST(BINLOG_NAME)
+};
+
+#define BINLOG_ID_NUM                           (sizeof(s_fmt) / sizeof(s_fmt[0]))
+
+static unsigned long s_record_cnt = 0;
+static unsigned long s_error_cnt = 0;
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+static unsigned long get32(const unsigned char *p)
+{
+    return (unsigned long)p[0] |
+           ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) |
+           ((unsigned long)p[3] << 24);
+}
+
+/* 32-bit target value to host long, sign extend for %d / %i */
+static void convert_args(const char *fmt, const unsigned long *raw, long *out, unsigned int nargs)
+{
+    unsigned int n = 0;
+    const char *p = fmt;
+
+    while ((*p != '\0') && (n < nargs))
+    {
+        if (*p++ != '%')
+            continue;
+
+        if (*p == '%')
+        {
+            p++;
+            continue;
+        }
+
+        while ((*p != '\0') && (strchr("diouxXc", *p) == NULL))
+            p++;
+
+        if ((*p == 'd') || (*p == 'i'))
+            out[n] = (long)(int)(unsigned int)raw[n];
+        else
+            out[n] = (long)raw[n];
+
+        n++;
+    }
+
+    for (; n < nargs; n++)
+        out[n] = (long)raw[n];
+}
+
+static void print_record(const unsigned char *rec)
+{
+    unsigned char id = rec[1];
+    unsigned char nargs = rec[2];
+    unsigned long ts = get32(&rec[3]);
+    unsigned long raw[BINLOG_MAX_ARGS] = {0};
+    long args[BINLOG_MAX_ARGS] = {0};
+    unsigned int i;
+
+    for (i = 0; i < nargs; i++)
+        raw[i] = get32(&rec[7 + (4 * i)]);
+
+    printf("[%10lu] ", ts);
+
+    if (id >= BINLOG_ID_NUM)
+    {
+        printf("<unknown id %u>\n", id);
+        return;
+    }
+
+    convert_args(s_fmt[id], raw, args, nargs);
+    printf(s_fmt[id], args[0], args[1], args[2], args[3]);
+}
+
+int main(int argc, char **argv)
+{
+    FILE *fp = stdin;
+    unsigned char rec[BINLOG_MAX_RECORD];
+    unsigned int pos = 0;
+    unsigned int need = 0;
+    unsigned char chk;
+    unsigned int i;
+    int c;
+
+    if (argc > 1)
+    {
+        fp = fopen(argv[1], "rb");
+        if (fp == NULL)
+        {
+            perror(argv[1]);
+            return 1;
+        }
+    }
+
+    while ((c = fgetc(fp)) != EOF)
+    {
+        if (pos == 0)
+        {
+            if ((unsigned int)c == BINLOG_SYNC)
+                rec[pos++] = (unsigned char)c;
+            else
+                putchar(c);     /* text output */
+            continue;
+        }
+
+        rec[pos++] = (unsigned char)c;
+
+        if (pos == 3)
+        {
+            if (rec[2] > BINLOG_MAX_ARGS)
+            {
+                s_error_cnt++;
+                pos = 0;
+                continue;
+            }
+            need = 3U + 4U + (4U * rec[2]) + 1U;
+        }
+
+        if ((pos > 3) && (pos == need))
+        {
+            chk = 0;
+            for (i = 1; i < need - 1U; i++)
+                chk ^= rec[i];
+
+            if (chk == rec[need - 1U])
+            {
+                print_record(rec);
+                s_record_cnt++;
+            }
+            else
+            {
+                s_error_cnt++;
+            }
+            pos = 0;
+        }
+    }
+
+    fprintf(stderr, "\n%lu record, %lu error, %u id (%s .. %s)\n",
+            s_record_cnt, s_error_cnt, (unsigned int)BINLOG_ID_NUM,
+            s_name[0], s_name[BINLOG_ID_NUM - 1]);
+
+    if (fp != stdin)
+        fclose(fp);
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+ * host side image trailer for boot_verify.c
+ *
+ * build : gcc -O2 -o boot_trailer boot_trailer.c
+ * usage : boot_trailer Template.bin [output.bin]     (in place if no output)
+ *
+ * fromelf bin of APROM image is padded with 0xFF to BOOT_VERIFY_ALIGN , then
+ * BOOT_VERIFY_TRAILER_T (magic , padded length , CRC-32 IEEE , ~CRC) little endian is appended
+ * run on the bin of the same build only : trailer length must match the linker load region end
+ */
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/* same as boot_verify.h */
+#define BOOT_VERIFY_APROM_SIZE                  (0x20000UL)
+#define BOOT_VERIFY_ALIGN                       (512UL)
+#define BOOT_VERIFY_MAGIC                       (0x31545642UL)
+#define BOOT_VERIFY_TRAILER_SIZE                (16UL)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* CRC-32 IEEE , reflected , init / xorout 0xFFFFFFFF , CRC_SERVICE_CRC32 */
+static unsigned long crc32(const unsigned char *p, unsigned long len)
+{
+    unsigned long crc = 0xFFFFFFFFUL;
+    int k;
+
+    while (len--)
+    {
+        crc ^= *p++;
+        for (k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ ((crc & 1UL) ? 0xEDB88320UL : 0UL);
+    }
+
+    return crc ^ 0xFFFFFFFFUL;
+}
+
+static void put32(unsigned char *p, unsigned long v)
+{
+    p[0] = (unsigned char)v;
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return (unsigned long)p[0] |
+           ((unsigned long)p[1] << 8) |
+           ((unsigned long)p[2] << 16) |
+           ((unsigned long)p[3] << 24);
+}
+
+int main(int argc, char **argv)
+{
+    static unsigned char img[BOOT_VERIFY_APROM_SIZE + BOOT_VERIFY_ALIGN];
+    const char *out;
+    unsigned long len;
+    unsigned long pad;
+    unsigned long crc;
+    FILE *f;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage : %s image.bin [output.bin]\n", argv[0]);
+        return 1;
+    }
+
+    out = (argc > 2) ? argv[2] : argv[1];
+
+    f = fopen(argv[1], "rb");
+    if (f == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    len = (unsigned long)fread(img, 1, sizeof(img), f);
+    fclose(f);
+
+    /* already has a trailer : run twice on the same bin */
+    if ((len >= BOOT_VERIFY_TRAILER_SIZE) && ((len % BOOT_VERIFY_ALIGN) == BOOT_VERIFY_TRAILER_SIZE) &&
+        (get32(&img[len - 16]) == BOOT_VERIFY_MAGIC) && (get32(&img[len - 12]) == len - BOOT_VERIFY_TRAILER_SIZE))
+    {
+        fprintf(stderr, "%s : trailer already present\n", argv[1]);
+        return 1;
+    }
+
+    pad = (len + BOOT_VERIFY_ALIGN - 1UL) & ~(BOOT_VERIFY_ALIGN - 1UL);
+    if ((len == 0UL) || ((pad + BOOT_VERIFY_TRAILER_SIZE) > BOOT_VERIFY_APROM_SIZE))
+    {
+        fprintf(stderr, "%s : %lu byte , no room for trailer in %lu byte APROM\n",
+                argv[1], len, BOOT_VERIFY_APROM_SIZE);
+        return 1;
+    }
+
+    memset(&img[len], 0xFF, pad - len);
+    crc = crc32(img, pad);
+
+    put32(&img[pad + 0], BOOT_VERIFY_MAGIC);
+    put32(&img[pad + 4], pad);
+    put32(&img[pad + 8], crc);
+    put32(&img[pad + 12], crc ^ 0xFFFFFFFFUL);
+
+    f = fopen(out, "wb");
+    if (f == NULL)
+    {
+        perror(out);
+        return 1;
+    }
+
+    if (fwrite(img, 1, pad + BOOT_VERIFY_TRAILER_SIZE, f) != pad + BOOT_VERIFY_TRAILER_SIZE)
+    {
+        perror(out);
+        fclose(f);
+        return 1;
+    }
+
+    fclose(f);
+
+    printf("%s : image %lu byte , padded %lu , crc %08lX\n", out, len, pad, crc);
+
+    return 0;
+}
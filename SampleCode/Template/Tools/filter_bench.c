@@ -0,0 +1,242 @@
+/*
+ * host side check and benchmark for dsp_filter.c
+ *
+ * build : gcc -O2 -DDSP_FILTER_HOST -o filter_bench filter_bench.c ../dsp_filter.c
+ * usage : filter_bench [sample_count]
+ *
+ * every kernel run block by block (DSP_FILTER_BENCH_LEN) and is compared with a
+ * direct reference (double for biquad) , then timed : ns and TSC cycle (x86) per sample
+ * target number : shell "filterbench" with ENABLE_FILTER_BENCH
+ */
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined (__x86_64__) || defined (__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "../dsp_filter.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define BENCH_DEFAULT_COUNT                     (1UL << 20)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* 2nd order Butterworth low pass , fc = fs / 10 */
+static const int16_t s_coef[5] =
+{
+    DSP_Q14(0.0674553), DSP_Q14(0.1349105), DSP_Q14(0.0674553), DSP_Q14(-1.1429805), DSP_Q14(0.4128016)
+};
+
+static int16_t *s_in;
+static int16_t *s_out;
+static unsigned long s_count;
+
+static DSP_MA_T     s_ma;
+static DSP_CIC_T    s_cic;
+static DSP_BIQUAD_T s_biquad;
+static DSP_MEDIAN_T s_median;
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+static unsigned long long tsc(void)
+{
+    #if defined (__x86_64__) || defined (__i386__)
+    return __rdtsc();
+    #else
+    return 0ULL;
+    #endif
+}
+
+static double now(void)
+{
+    struct timespec t;
+
+    clock_gettime(CLOCK_MONOTONIC, &t);
+
+    return (double)t.tv_sec + (double)t.tv_nsec / 1e9;
+}
+
+static int cmp16(const void *a, const void *b)
+{
+    return (int)*(const int16_t *)a - (int)*(const int16_t *)b;
+}
+
+/* op : 0 ma 16 , 1 cic 3x8 , 2 biquad , 3 median 5 , 4 median 9 , return output count */
+static unsigned long run(int op)
+{
+    unsigned long i;
+    unsigned long n;
+    unsigned long cnt = 0;
+
+    switch (op)
+    {
+        case 0: DspFilter_MaInit(&s_ma, 4); break;
+        case 1: DspFilter_CicInit(&s_cic, 3, 3); break;
+        case 2: DspFilter_BiquadInit(&s_biquad, s_coef, 1); break;
+        case 3: DspFilter_MedianInit(&s_median, 5); break;
+        default: DspFilter_MedianInit(&s_median, 9); break;
+    }
+
+    for (i = 0; i < s_count; i += n)
+    {
+        n = s_count - i;
+        if (n > DSP_FILTER_BENCH_LEN)
+            n = DSP_FILTER_BENCH_LEN;
+
+        switch (op)
+        {
+            case 0: DspFilter_Ma(&s_ma, &s_in[i], &s_out[cnt], (unsigned int)n); cnt += n; break;
+            case 1: cnt += DspFilter_Cic(&s_cic, &s_in[i], &s_out[cnt], (unsigned int)n); break;
+            case 2: DspFilter_Biquad(&s_biquad, &s_in[i], &s_out[cnt], (unsigned int)n); cnt += n; break;
+            default: DspFilter_Median(&s_median, &s_in[i], &s_out[cnt], (unsigned int)n); cnt += n; break;
+        }
+    }
+
+    return cnt;
+}
+
+/* return number of mismatch , biquad : max error in LSB */
+static unsigned long check(int op, unsigned long cnt)
+{
+    unsigned long bad = 0;
+    unsigned long i;
+    long k;
+    long sum;
+    long ref;
+    int16_t win[DSP_FILTER_MEDIAN_MAX];
+    int len;
+    double c[5];
+    double x1 = 0, x2 = 0, y1 = 0, y2 = 0, y;
+    double err;
+    double maxerr = 0;
+
+    /* reference use the same Q14 coefficient : error is arithmetic rounding only */
+    for (k = 0; k < 5; k++)
+        c[k] = s_coef[k] / 16384.0;
+
+    for (i = 0; i < cnt; i++)
+    {
+        switch (op)
+        {
+            case 0:
+                for (sum = 0, k = 0; k < 16; k++)
+                    sum += ((long)i - k >= 0) ? s_in[i - k] : 0;
+                ref = sum >> 4;
+                break;
+
+            case 1:
+                /* CIC 3 x 8 = 3 cascaded 8 tap box filter , decimated */
+                {
+                    long a[3][24];
+                    long base = (long)(i + 1) * 8 - 1;
+                    int s, t, j;
+
+                    for (t = 0; t < 24; t++)
+                        a[0][t] = (base - t >= 0) ? s_in[base - t] : 0;
+                    for (s = 1; s < 3; s++)
+                        for (t = 0; t < 24 - 7 * s; t++)
+                            for (a[s][t] = 0, j = 0; j < 8; j++)
+                                a[s][t] += a[s - 1][t + j];
+                    for (sum = 0, j = 0; j < 8; j++)
+                        sum += a[2][j];
+                    ref = sum >> 9;
+                }
+                break;
+
+            case 2:
+                y  = c[0] * s_in[i] + c[1] * x1 + c[2] * x2 - c[3] * y1 - c[4] * y2;
+                x2 = x1;
+                x1 = s_in[i];
+                y2 = y1;
+                y1 = y;
+                err = y - s_out[i];
+                if (err < 0)
+                    err = -err;
+                if (err > maxerr)
+                    maxerr = err;
+                continue;
+
+            default:
+                len = (op == 3) ? 5 : 9;
+                for (k = 0; k < len; k++)
+                    win[k] = ((long)i - k >= 0) ? s_in[i - k] : 0;
+                qsort(win, (size_t)len, sizeof(win[0]), cmp16);
+                ref = win[len / 2];
+                break;
+        }
+
+        if (ref != s_out[i])
+            bad++;
+    }
+
+    return (op == 2) ? (unsigned long)(maxerr + 0.5) : bad;
+}
+
+int main(int argc, char **argv)
+{
+    static const char * const name[5] = {"ma 16", "cic 3x8", "biquad", "median 5", "median 9"};
+    unsigned long long c0;
+    unsigned long long c1;
+    unsigned long cnt;
+    unsigned long i;
+    unsigned long bad;
+    double t0;
+    double t1;
+    int fail = 0;
+    int op;
+
+    s_count = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_DEFAULT_COUNT;
+    if (s_count == 0)
+        s_count = BENCH_DEFAULT_COUNT;
+
+    s_in  = malloc(s_count * sizeof(int16_t));
+    s_out = malloc(s_count * sizeof(int16_t));
+    if ((s_in == NULL) || (s_out == NULL))
+        return 1;
+
+    /* slow ramp of 12 bit ADC code + noise + spike , as DSP_FILTER_ADC_TO_Q15 would give */
+    srand(1);
+    for (i = 0; i < s_count; i++)
+    {
+        unsigned int adc = (unsigned int)((i / 64) % 3000) + 500 + (unsigned int)(rand() % 64);
+        if ((rand() % 100) == 0)
+            adc = 4095;
+        s_in[i] = DSP_FILTER_ADC_TO_Q15(adc);
+    }
+
+    printf("%lu sample , block %u\n", s_count, DSP_FILTER_BENCH_LEN);
+
+    for (op = 0; op < 5; op++)
+    {
+        t0  = now();
+        c0  = tsc();
+        cnt = run(op);
+        c1  = tsc();
+        t1  = now();
+
+        bad = check(op, (op == 2) ? cnt : ((cnt < 20000) ? cnt : 20000));
+
+        if (op == 2)
+        {
+            printf("%-8s : %6.2f ns , %6.1f TSC cycle / sample , max error %lu LSB\n", name[op],
+                   (t1 - t0) * 1e9 / (double)s_count, (double)(c1 - c0) / (double)s_count, bad);
+            fail |= (bad > 4);
+        }
+        else
+        {
+            printf("%-8s : %6.2f ns , %6.1f TSC cycle / sample , %lu mismatch\n", name[op],
+                   (t1 - t0) * 1e9 / (double)s_count, (double)(c1 - c0) / (double)s_count, bad);
+            fail |= (bad != 0);
+        }
+    }
+
+    free(s_in);
+    free(s_out);
+
+    return fail ? 2 : 0;
+}
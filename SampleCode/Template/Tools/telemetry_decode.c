@@ -0,0 +1,240 @@
+/*
+ * host side decoder for telemetry.c frame
+ *
+ * build : gcc -O2 -o telemetry_decode telemetry_decode.c
+ * usage : telemetry_decode [-q] [-b baudrate] [capture.bin]     (stdin if no file)
+ *
+ * frame : 0x00 | COBS( type | seq | payload | CRC-32 LE ) | 0x00
+ * report frame / CRC error / sequence gap , throughput against line rate if -b given
+ */
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define TELEMETRY_MAX_PAYLOAD                   (128U)
+#define TELEMETRY_RAW_MAX                       (2U + TELEMETRY_MAX_PAYLOAD + 4U)
+#define TELEMETRY_FRAME_MAX                     (TELEMETRY_RAW_MAX + ((TELEMETRY_RAW_MAX + 253U) / 254U))
+
+#define TELEMETRY_TYPE_TIMER_STATS              (0x01U)
+#define TELEMETRY_TYPE_SENSOR                   (0x02U)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static unsigned long s_crc_table[256];
+
+static unsigned long s_frame_cnt = 0;
+static unsigned long s_crc_err = 0;
+static unsigned long s_cobs_err = 0;
+static unsigned long s_seq_gap = 0;
+static unsigned long s_byte_cnt = 0;
+static unsigned long s_payload_cnt = 0;
+
+static int s_quiet = 0;
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+static void crc32_init(void)
+{
+    unsigned long c;
+    unsigned int i;
+    unsigned int k;
+
+    for (i = 0; i < 256; i++)
+    {
+        c = i;
+        for (k = 0; k < 8; k++)
+            c = (c & 1) ? (0xEDB88320UL ^ (c >> 1)) : (c >> 1);
+        s_crc_table[i] = c;
+    }
+}
+
+static unsigned long crc32(const unsigned char *p, unsigned int len)
+{
+    unsigned long c = 0xFFFFFFFFUL;
+
+    while (len--)
+        c = s_crc_table[(c ^ *p++) & 0xFF] ^ (c >> 8);
+
+    return (c ^ 0xFFFFFFFFUL) & 0xFFFFFFFFUL;
+}
+
+static unsigned long get16(const unsigned char *p)
+{
+    return (unsigned long)p[0] | ((unsigned long)p[1] << 8);
+}
+
+static unsigned long get32(const unsigned char *p)
+{
+    return get16(p) | (get16(p + 2) << 16);
+}
+
+/* return decoded length , -1 on malformed input */
+static int cobs_decode(const unsigned char *src, unsigned int len, unsigned char *dst, unsigned int max)
+{
+    unsigned int i = 0;
+    unsigned int n = 0;
+    unsigned int code;
+    unsigned int k;
+
+    while (i < len)
+    {
+        code = src[i++];
+        if (code == 0)
+            return -1;
+
+        for (k = 1; k < code; k++)
+        {
+            if ((i >= len) || (n >= max))
+                return -1;
+            dst[n++] = src[i++];
+        }
+
+        if ((code < 0xFF) && (i < len))
+        {
+            if (n >= max)
+                return -1;
+            dst[n++] = 0;
+        }
+    }
+
+    return (int)n;
+}
+
+static void print_payload(unsigned char type, const unsigned char *p, unsigned int len)
+{
+    unsigned int i;
+
+    if ((type == TELEMETRY_TYPE_TIMER_STATS) && (len >= 20))
+    {
+        printf("tick %lu , queue max %u ovf %lu , post max %u ovf %lu , util %lu , exhaust %lu",
+               get32(&p[0]), p[4], get32(&p[8]), p[5], get32(&p[12]), get16(&p[6]), get32(&p[16]));
+        return;
+    }
+
+    for (i = 0; i < len; i++)
+        printf("%02X ", p[i]);
+}
+
+static void handle_frame(const unsigned char *enc, unsigned int len)
+{
+    static int last_seq = -1;
+    unsigned char raw[TELEMETRY_RAW_MAX];
+    unsigned long crc;
+    int n;
+
+    if (len == 0)
+        return;     /* back to back delimiter */
+
+    n = cobs_decode(enc, len, raw, sizeof(raw));
+    if (n < 6)
+    {
+        s_cobs_err++;
+        return;
+    }
+
+    crc = get32(&raw[n - 4]);
+    if (crc != crc32(raw, (unsigned int)n - 4))
+    {
+        s_crc_err++;
+        if (!s_quiet)
+            printf("crc error , %d byte\n", n);
+        return;
+    }
+
+    if ((last_seq >= 0) && (raw[1] != (unsigned char)(last_seq + 1)))
+        s_seq_gap++;
+    last_seq = raw[1];
+
+    s_frame_cnt++;
+    s_payload_cnt += (unsigned long)n - 6;
+
+    if (!s_quiet)
+    {
+        printf("type %02X seq %3u len %3d : ", raw[0], raw[1], n - 6);
+        print_payload(raw[0], &raw[2], (unsigned int)n - 6);
+        printf("\n");
+    }
+}
+
+int main(int argc, char **argv)
+{
+    FILE *fp = stdin;
+    unsigned char enc[TELEMETRY_FRAME_MAX + 1];
+    unsigned int pos = 0;
+    unsigned int overlong = 0;
+    unsigned long baud = 0;
+    struct timespec t0;
+    struct timespec t1;
+    double sec;
+    int c;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-q") == 0)
+            s_quiet = 1;
+        else if ((strcmp(argv[i], "-b") == 0) && (i + 1 < argc))
+            baud = strtoul(argv[++i], NULL, 0);
+        else
+        {
+            fp = fopen(argv[i], "rb");
+            if (fp == NULL)
+            {
+                perror(argv[i]);
+                return 1;
+            }
+        }
+    }
+
+    crc32_init();
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+
+    while ((c = fgetc(fp)) != EOF)
+    {
+        s_byte_cnt++;
+
+        if (c == 0)
+        {
+            if (overlong)
+                s_cobs_err++;
+            else
+                handle_frame(enc, pos);
+            pos = 0;
+            overlong = 0;
+            continue;
+        }
+
+        if (pos < sizeof(enc))
+            enc[pos++] = (unsigned char)c;
+        else
+            overlong = 1;   /* text or noise between frame */
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    sec = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    fprintf(stderr, "\n%lu frame , %lu crc error , %lu cobs error , %lu seq gap\n",
+            s_frame_cnt, s_crc_err, s_cobs_err, s_seq_gap);
+    fprintf(stderr, "%lu byte on wire , %lu payload byte (%.1f %% efficiency)\n",
+            s_byte_cnt, s_payload_cnt,
+            s_byte_cnt ? (100.0 * (double)s_payload_cnt / (double)s_byte_cnt) : 0.0);
+
+    if (sec > 0.0)
+    {
+        fprintf(stderr, "%.3f s , %.0f byte/s", sec, (double)s_byte_cnt / sec);
+        if (baud != 0)
+            fprintf(stderr, " , %.1f %% of %lu baud (8N1)", 100.0 * ((double)s_byte_cnt * 10.0 / sec) / (double)baud, baud);
+        fprintf(stderr, "\n");
+    }
+
+    if (fp != stdin)
+        fclose(fp);
+
+    return (s_crc_err || s_cobs_err) ? 2 : 0;
+}
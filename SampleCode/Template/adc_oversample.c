@@ -0,0 +1,339 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "adc_oversample.h"
+#include "pdma_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#if defined (ENABLE_ADC_STREAM) && defined (ENABLE_ADC_OVERSAMPLE)
+#error "ENABLE_ADC_STREAM and ENABLE_ADC_OVERSAMPLE both own ADC"
+#endif
+
+/* first conversion after channel switch is dropped : stale PDMA request , sample cap settle */
+#define ADC_OVS_BUF_SIZE                        ((1U << (2U * ADC_OVS_MAX_BITS)) + 1U)
+
+typedef struct _adc_ovs_t
+{
+    unsigned short           buf[ADC_OVS_BUF_SIZE];
+    unsigned long            table[ADC_OVS_CH_NUM];     /* seq << 16 | value */
+    unsigned long            chmask;
+    unsigned long            roundcnt;
+    unsigned long            misscnt;
+    unsigned short           count;         /* 4^bits */
+    unsigned short           period;
+    unsigned char            bits;
+    unsigned char            cur;           /* channel being converted */
+    unsigned char            ch;            /* from PdmaService_AllocChannel */
+    unsigned char            running;
+    unsigned char            busy;          /* round in progress */
+    unsigned char            reserved[3];
+
+} ADC_OVS_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile ADC_OVS_T g_AdcOvs;
+static int g_AdcOvsTimerId = -1;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define ADC_OVS_ENTER_CRITICAL(m)               do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define ADC_OVS_EXIT_CRITICAL(m)                __set_PRIMASK(m)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long AdcOvs_GetRoundCnt(void)
+{
+    return g_AdcOvs.roundcnt;
+}
+
+unsigned long AdcOvs_GetMissCnt(void)
+{
+    return g_AdcOvs.misscnt;
+}
+
+unsigned char AdcOvs_GetBits(void)
+{
+    return g_AdcOvs.bits;
+}
+
+unsigned short AdcOvs_Read(unsigned char ch, unsigned short *value)
+{
+    unsigned long w;
+
+    if (ch >= ADC_OVS_CH_NUM)
+    {
+        return 0U;
+    }
+
+    /* one word load , value and seq always from the same publish */
+    w = g_AdcOvs.table[ch];
+
+    if (value != (unsigned short *)0)
+    {
+        *value = (unsigned short)(w & ADC_OVS_VALUE_Msk);
+    }
+
+    return (unsigned short)(w >> ADC_OVS_SEQ_Pos);
+}
+
+/* next channel of mask after cur , ADC_OVS_CH_NONE if cur was last , cur ADC_OVS_CH_NONE : first channel */
+static unsigned char AdcOvs_NextCh(unsigned char cur)
+{
+    unsigned char i;
+
+    for (i = (unsigned char)(cur + 1U); i < ADC_OVS_CH_NUM; i++)
+    {
+        if (g_AdcOvs.chmask & (1UL << i))
+        {
+            return i;
+        }
+    }
+
+    return ADC_OVS_CH_NONE;
+}
+
+/* ISR or critical section */
+static void AdcOvs_StartBurst(unsigned char adc_ch)
+{
+    volatile ADC_OVS_T *o;
+    o = &g_AdcOvs;
+
+    o->cur = adc_ch;
+
+    ADC_STOP_CONV(ADC_OVS_PORT);
+    ADC_SET_INPUT_CHANNEL(ADC_OVS_PORT, 1UL << adc_ch);
+
+    PDMA->DSCT[o->ch].SA  = (uint32_t)&ADC_OVS_PORT->ADPDMA;
+    PDMA->DSCT[o->ch].DA  = (uint32_t)&o->buf[0];
+    PDMA->DSCT[o->ch].CTL = ((unsigned long)o->count << PDMA_DSCT_CTL_TXCNT_Pos) |     /* count + 1 transfer */
+                            PDMA_WIDTH_16 | PDMA_SAR_FIX | PDMA_DAR_INC | PDMA_REQ_SINGLE | PDMA_OP_BASIC;
+
+    ADC_START_CONV(ADC_OVS_PORT);
+}
+
+/* accumulate and shift , publish with next sequence */
+static void AdcOvs_Publish(void)
+{
+    volatile ADC_OVS_T *o;
+    const volatile unsigned short *p;
+    unsigned long sum;
+    unsigned long seq;
+    unsigned int n;
+
+    o = &g_AdcOvs;
+    p = &o->buf[1];
+    n = o->count;
+    sum = 0UL;
+
+    /* count is power of 4 , 4 per loop */
+    while (n != 0U)
+    {
+        sum += (unsigned long)p[0] + (unsigned long)p[1] + (unsigned long)p[2] + (unsigned long)p[3];
+        p += 4;
+        n -= 4U;
+    }
+
+    seq = (o->table[o->cur] >> ADC_OVS_SEQ_Pos) + 1UL;
+    if (seq > 0xFFFFUL)
+    {
+        seq = 1UL;
+    }
+
+    o->table[o->cur] = (seq << ADC_OVS_SEQ_Pos) | ((sum >> o->bits) & ADC_OVS_VALUE_Msk);
+}
+
+/* PDMA IRQ , burst of one channel done */
+static void AdcOvs_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    volatile ADC_OVS_T *o;
+    unsigned char next;
+
+    (void)ch;
+    (void)user_data;
+
+    o = &g_AdcOvs;
+
+    if ((event & PDMA_SERVICE_EVT_DONE) == 0U)
+    {
+        o->busy = 0U;     /* abort : next round restart */
+        ADC_STOP_CONV(ADC_OVS_PORT);
+        return;
+    }
+
+    ADC_STOP_CONV(ADC_OVS_PORT);
+
+    if (o->running == 0U)
+    {
+        o->busy = 0U;
+        return;
+    }
+
+    AdcOvs_Publish();
+
+    next = AdcOvs_NextCh(o->cur);
+    if (next == ADC_OVS_CH_NONE)
+    {
+        o->roundcnt++;
+
+        if (o->period != 0U)
+        {
+            o->busy = 0U;    /* wait for round timer */
+            return;
+        }
+
+        next = AdcOvs_NextCh(ADC_OVS_CH_NONE);
+    }
+
+    AdcOvs_StartBurst(next);
+}
+
+/* round timer , run in TimerService_Dispatch */
+static void AdcOvs_Kick(void *user_data)
+{
+    volatile ADC_OVS_T *o;
+    uint32_t primask;
+
+    (void)user_data;
+
+    o = &g_AdcOvs;
+
+    ADC_OVS_ENTER_CRITICAL(primask);
+
+    if (o->running && (o->busy == 0U))
+    {
+        o->busy = 1U;
+        AdcOvs_StartBurst(AdcOvs_NextCh(ADC_OVS_CH_NONE));
+    }
+    else if (o->running)
+    {
+        o->misscnt++;
+    }
+
+    ADC_OVS_EXIT_CRITICAL(primask);
+}
+
+void AdcOvs_Stop(void)
+{
+    volatile ADC_OVS_T *o;
+    uint32_t primask;
+
+    o = &g_AdcOvs;
+
+    if (o->ch == ADC_OVS_CH_NONE)
+    {
+        return;
+    }
+
+    if (g_AdcOvsTimerId >= 0)
+    {
+        TimerService_StopTimer((unsigned int)g_AdcOvsTimerId);
+    }
+
+    ADC_OVS_ENTER_CRITICAL(primask);
+
+    o->running = 0U;
+    o->busy    = 0U;
+
+    ADC_STOP_CONV(ADC_OVS_PORT);
+    ADC_DISABLE_PDMA(ADC_OVS_PORT);
+    PDMA_STOP(PDMA, o->ch);
+    PDMA_CLR_TD_FLAG(PDMA, 1UL << o->ch);
+
+    ADC_OVS_EXIT_CRITICAL(primask);
+}
+
+int AdcOvs_Start(unsigned short period_ms)
+{
+    volatile ADC_OVS_T *o;
+
+    o = &g_AdcOvs;
+
+    if (o->ch == ADC_OVS_CH_NONE)
+    {
+        return -1;
+    }
+
+    AdcOvs_Stop();
+
+    if (period_ms != 0U)
+    {
+        if (g_AdcOvsTimerId < 0)
+        {
+            g_AdcOvsTimerId = TimerService_CreateTimerQueue(period_ms, AdcOvs_Kick, (void *)0);
+            if (g_AdcOvsTimerId < 0)
+            {
+                return -1;
+            }
+        }
+        else
+        {
+            TimerService_ChangePeriod((unsigned int)g_AdcOvsTimerId, period_ms);
+        }
+    }
+
+    o->period  = period_ms;
+    o->running = 1U;
+
+    PDMA->CHCTL |= (1UL << o->ch);
+    PDMA_EnableInt(PDMA, o->ch, PDMA_INT_TRANS_DONE);
+    ADC_ENABLE_PDMA(ADC_OVS_PORT);
+
+    AdcOvs_Kick((void *)0);
+
+    if (period_ms != 0U)
+    {
+        TimerService_StartTimer((unsigned int)g_AdcOvsTimerId);
+    }
+
+    return 0;
+}
+
+int AdcOvs_Init(unsigned long ch_mask, unsigned char bits, unsigned char ext_sample)
+{
+    volatile ADC_OVS_T *o;
+    unsigned char i;
+    int ch;
+
+    o = &g_AdcOvs;
+    o->ch      = ADC_OVS_CH_NONE;
+    o->running = 0U;
+    o->busy    = 0U;
+
+    if ((bits == 0U) || (bits > ADC_OVS_MAX_BITS) || (ch_mask == 0UL) || (ch_mask >> ADC_OVS_CH_NUM))
+    {
+        return -1;
+    }
+
+    for (i = 0U; i < ADC_OVS_CH_NUM; i++)
+    {
+        o->table[i] = 0UL;
+    }
+
+    o->chmask   = ch_mask;
+    o->bits     = bits;
+    o->count    = (unsigned short)(1U << (2U * bits));
+    o->roundcnt = 0UL;
+    o->misscnt  = 0UL;
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, AdcOvs_PdmaHook, (void *)0);
+    if (ch < 0)
+    {
+        return -1;
+    }
+
+    o->ch = (unsigned char)ch;
+
+    /* request source only , descriptor written per burst */
+    PDMA_SetTransferMode(PDMA, o->ch, PDMA_ADC_RX, FALSE, 0);
+    PDMA->DSCT[o->ch].CTL = 0UL;
+
+    ADC_POWER_ON(ADC_OVS_PORT);
+    ADC_Open(ADC_OVS_PORT, ADC_ADCR_DIFFEN_SINGLE_END, ADC_ADCR_ADMD_CONTINUOUS, 1UL << AdcOvs_NextCh(ADC_OVS_CH_NONE));
+    ADC_SetExtendSampleTime(ADC_OVS_PORT, 0, ext_sample);
+
+    return 0;
+}
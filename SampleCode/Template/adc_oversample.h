@@ -0,0 +1,61 @@
+#ifndef __ADC_OVERSAMPLE_H__
+#define __ADC_OVERSAMPLE_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * ADC oversampling : 4^n conversion per channel , decimate by accumulate and shift n , 12 + n bit result
+ *
+ * one channel at a time in ADCHER , continuous conversion at ADC rate , PDMA collect 4^n result
+ * PDMA done IRQ : sum , shift , publish , switch ADCHER to next channel of mask , start next burst
+ * round : every channel of mask once , next round start at once (period 0) or from TimerService period
+ *
+ * latest value table : value and sequence packed in one 32 bit word , single store / load , no lock
+ * ADC is owned by this module , not together with adc_stream.c
+ */
+#define ADC_OVS_PORT                            (ADC)
+#define ADC_OVS_CH_MASK                         (BIT0 | BIT1)   /* PB.0 , PB.1 , pin set in SYS_Init */
+#define ADC_OVS_CH_NUM                          (16U)
+#define ADC_OVS_MAX_BITS                        (4U)            /* 4^4 = 256 conversion , 16 bit result */
+
+#define ADC_OVS_CH_NONE                         (0xFFU)
+
+/* table word */
+#define ADC_OVS_VALUE_Msk                       (0x0000FFFFUL)
+#define ADC_OVS_SEQ_Pos                         (16U)           /* 0 : never sampled */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * call after PdmaService_Init , ADC clock enabled in SYS_Init
+ * bits        : extra resolution n , 1 .. ADC_OVS_MAX_BITS
+ * ext_sample  : ADC_SetExtendSampleTime , ADC clock 0 .. 255 , for high impedance source
+ * return 0 , -1 if parameter out of range or no PDMA channel
+ */
+int  AdcOvs_Init(unsigned long ch_mask, unsigned char bits, unsigned char ext_sample);
+
+/* period_ms : round start interval , 0 : back to back */
+int  AdcOvs_Start(unsigned short period_ms);
+void AdcOvs_Stop(void);
+
+/*
+ * any context , no lock
+ * return sequence (1 .. 65535 , wrap skip 0) of value , 0 if channel not sampled yet
+ */
+unsigned short AdcOvs_Read(unsigned char ch, unsigned short *value);
+
+unsigned long AdcOvs_GetRoundCnt(void);
+unsigned long AdcOvs_GetMissCnt(void);     /* round timer fired while previous round still running */
+unsigned char AdcOvs_GetBits(void);
+
+#endif //__ADC_OVERSAMPLE_H__
@@ -0,0 +1,241 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "adc_stream.h"
+#include "pdma_service.h"
+#include "pdma_sg.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _adc_stream_t
+{
+    unsigned short           buf[2][ADC_STREAM_BLOCK];
+    unsigned long            donecnt;       /* free running block , written by PDMA IRQ */
+    unsigned long            readcnt;       /* free running block , written by AdcStream_Process */
+    unsigned long            dropcnt;
+    unsigned long            overruncnt;
+    ADC_STREAM_CALLBACK_T    callback;
+    void                    *user_data;
+    unsigned char            ch;            /* from PdmaService_AllocChannel */
+    unsigned char            posted;
+    unsigned char            running;
+    unsigned char            reserved;
+
+} ADC_STREAM_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile ADC_STREAM_T g_AdcStream;
+
+/* descriptor in SRAM , A -> B -> A ... */
+static DSCT_T g_AdcStreamDesc[2];
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long AdcStream_GetBlockCnt(void)
+{
+    return g_AdcStream.donecnt;
+}
+
+unsigned long AdcStream_GetDropCnt(void)
+{
+    return g_AdcStream.dropcnt;
+}
+
+unsigned long AdcStream_GetOverrunCnt(void)
+{
+    return g_AdcStream.overruncnt;
+}
+
+int AdcStream_IsRunning(void)
+{
+    return g_AdcStream.running ? 1 : 0;
+}
+
+/* block consumer , run in TimerService_Dispatch */
+static void AdcStream_Process(void *user_data)
+{
+    volatile ADC_STREAM_T *a;
+    unsigned long seq;
+    unsigned long behind;
+
+    (void)user_data;
+
+    a = &g_AdcStream;
+    a->posted = 0U;
+
+    while (a->readcnt != a->donecnt)
+    {
+        /* only newest finished block is still intact */
+        behind = a->donecnt - a->readcnt;
+        if (behind > 1UL)
+        {
+            a->dropcnt += behind - 1UL;
+            a->readcnt  = a->donecnt - 1UL;
+        }
+
+        seq = a->readcnt;
+
+        if (a->callback != (ADC_STREAM_CALLBACK_T)0)
+        {
+            a->callback((const unsigned short *)&a->buf[seq & 1UL][0], ADC_STREAM_BLOCK, seq, a->user_data);
+        }
+
+        /* PDMA finished next block and started over this one while callback run */
+        if ((a->donecnt - seq) > 1UL)
+        {
+            a->overruncnt++;
+        }
+
+        a->readcnt = seq + 1UL;
+    }
+}
+
+/* PDMA IRQ , one half filled */
+static void AdcStream_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    volatile ADC_STREAM_T *a;
+
+    (void)ch;
+    (void)user_data;
+
+    a = &g_AdcStream;
+
+    if (event & PDMA_SERVICE_EVT_ABORT)
+    {
+        a->running = 0U;    /* channel disabled by PDMA , AdcStream_Start again */
+        return;
+    }
+
+    if (event & PDMA_SERVICE_EVT_DONE)
+    {
+        a->donecnt++;
+
+        if (a->posted == 0U)
+        {
+            if (TimerService_Post(AdcStream_Process, (void *)0) == 0)
+            {
+                a->posted = 1U;
+            }
+        }
+    }
+}
+
+/* A -> B -> A ... , done interrupt on each half */
+static void AdcStream_BuildRing(void)
+{
+    PDMA_SG_CHAIN_T chain;
+    unsigned char idx;
+
+    (void)PdmaSg_Init(&chain, g_AdcStreamDesc, 2U, PDMA_SG_INT_EACH);
+
+    for (idx = 0U; idx < 2U; idx++)
+    {
+        (void)PdmaSg_Add(&chain, (uint32_t)&ADC_STREAM_PORT->ADPDMA,
+                         (uint32_t)&g_AdcStream.buf[idx][0], ADC_STREAM_BLOCK * 2U,
+                         PDMA_WIDTH_16 | PDMA_SAR_FIX | PDMA_DAR_INC | PDMA_REQ_SINGLE);
+    }
+
+    (void)PdmaSg_MakeRing(&chain);
+}
+
+void AdcStream_Stop(void)
+{
+    volatile ADC_STREAM_T *a;
+    a = &g_AdcStream;
+
+    if (a->ch == ADC_STREAM_CH_NONE)
+    {
+        return;
+    }
+
+    TIMER_Stop(ADC_STREAM_TIMER);
+    ADC_DisableHWTrigger(ADC_STREAM_PORT);
+    ADC_STOP_CONV(ADC_STREAM_PORT);
+    ADC_DISABLE_PDMA(ADC_STREAM_PORT);
+
+    PDMA_DisableInt(PDMA, a->ch, PDMA_INT_TRANS_DONE);
+    PDMA_STOP(PDMA, a->ch);
+    PDMA_CLR_TD_FLAG(PDMA, 1UL << a->ch);
+
+    a->running = 0U;
+}
+
+int AdcStream_Start(unsigned long rate_hz)
+{
+    volatile ADC_STREAM_T *a;
+    a = &g_AdcStream;
+
+    if (a->ch == ADC_STREAM_CH_NONE)
+    {
+        return -1;
+    }
+
+    AdcStream_Stop();
+
+    /* old half-filled block is discarded , ring restart from descriptor A : next seq even (buf[seq & 1] = A) */
+    a->donecnt = (a->donecnt + 1UL) & ~1UL;
+    a->readcnt = a->donecnt;
+
+    PDMA->CHCTL |= (1UL << a->ch);
+    PDMA->DSCT[a->ch].CTL = 0UL;
+    PDMA_SetTransferMode(PDMA, a->ch, PDMA_ADC_RX, TRUE, (uint32_t)&g_AdcStreamDesc[0]);
+    PDMA_EnableInt(PDMA, a->ch, PDMA_INT_TRANS_DONE);
+
+    ADC_ENABLE_PDMA(ADC_STREAM_PORT);
+    a->running = 1U;
+
+    if (rate_hz == 0UL)
+    {
+        ADC_STREAM_PORT->ADCR = (ADC_STREAM_PORT->ADCR & ~ADC_ADCR_ADMD_Msk) | ADC_ADCR_ADMD_CONTINUOUS;
+        ADC_START_CONV(ADC_STREAM_PORT);
+        return 0;
+    }
+
+    /* one scan per TIMER timeout */
+    ADC_STREAM_PORT->ADCR = (ADC_STREAM_PORT->ADCR & ~ADC_ADCR_ADMD_Msk) | ADC_ADCR_ADMD_SINGLE_CYCLE;
+    ADC_EnableHWTrigger(ADC_STREAM_PORT, ADC_ADCR_TRGS_TIMER, 0);
+
+    (void)TIMER_Open(ADC_STREAM_TIMER, TIMER_PERIODIC_MODE, rate_hz);
+    TIMER_SetTriggerSource(ADC_STREAM_TIMER, TIMER_TRGSRC_TIMEOUT_EVENT);
+    TIMER_SetTriggerTarget(ADC_STREAM_TIMER, TIMER_TRG_TO_ADC);
+    TIMER_Start(ADC_STREAM_TIMER);
+
+    return 0;
+}
+
+int AdcStream_Init(ADC_STREAM_CALLBACK_T callback, void *user_data)
+{
+    volatile ADC_STREAM_T *a;
+    int ch;
+
+    a = &g_AdcStream;
+
+    a->donecnt    = 0UL;
+    a->readcnt    = 0UL;
+    a->dropcnt    = 0UL;
+    a->overruncnt = 0UL;
+    a->callback   = callback;
+    a->user_data  = user_data;
+    a->ch         = ADC_STREAM_CH_NONE;
+    a->posted     = 0U;
+    a->running    = 0U;
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, AdcStream_PdmaHook, (void *)0);
+    if (ch < 0)
+    {
+        return -1;
+    }
+
+    a->ch = (unsigned char)ch;
+
+    AdcStream_BuildRing();
+
+    ADC_POWER_ON(ADC_STREAM_PORT);
+    ADC_Open(ADC_STREAM_PORT, ADC_ADCR_DIFFEN_SINGLE_END, ADC_ADCR_ADMD_SINGLE_CYCLE, ADC_STREAM_CH_MASK);
+
+    return 0;
+}
@@ -0,0 +1,57 @@
+#ifndef __ADC_STREAM_H__
+#define __ADC_STREAM_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * continuous ADC acquisition
+ *
+ * TIMER timeout event trigger one single cycle scan of ADC_STREAM_CH_MASK , rate 0 : continuous scan (ADC full rate)
+ * PDMA move every result from ADPDMA into ping-pong buffer (two descriptor ring) , no per-sample interrupt
+ * PDMA done on each half = one block , callback(sample, count, seq) run in TimerService_Dispatch
+ *
+ * consumer own a block until callback return , PDMA is filling the other half meanwhile
+ * drop    : block completed while older block still waiting , older one skipped
+ * overrun : PDMA wrapped onto block during callback , data of that block is partly new
+ * restart : AdcStream_Start round seq up to even (buffer A) , one seq number may be skipped
+ */
+#define ADC_STREAM_PORT                         (ADC)
+#define ADC_STREAM_CH_MASK                      (BIT0)    /* PB.0 ADC0_CH0 , pin set in SYS_Init */
+#define ADC_STREAM_TIMER                        (TIMER2)
+#define ADC_STREAM_BLOCK                        (64U)     /* sample per block , multiple of channel count */
+
+#define ADC_STREAM_CH_NONE                      (0xFFU)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* sample interleaved in channel order when more than one channel in mask , 12 bit right aligned */
+typedef void (*ADC_STREAM_CALLBACK_T)(const unsigned short *sample, unsigned int count, unsigned long seq, void *user_data);
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * call after PdmaService_Init , ADC / TIMER2 clock enabled in SYS_Init
+ * power on and open ADC for ADC_STREAM_CH_MASK (no calibration run) , take one PDMA channel
+ * return 0 , -1 if no PDMA channel
+ */
+int  AdcStream_Init(ADC_STREAM_CALLBACK_T callback, void *user_data);
+
+/* rate_hz : scan per second , 0 : free running continuous scan */
+int  AdcStream_Start(unsigned long rate_hz);
+void AdcStream_Stop(void);
+
+int  AdcStream_IsRunning(void);
+
+unsigned long AdcStream_GetBlockCnt(void);
+unsigned long AdcStream_GetDropCnt(void);
+unsigned long AdcStream_GetOverrunCnt(void);
+
+#endif //__ADC_STREAM_H__
@@ -0,0 +1,105 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "binlog.h"
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#if defined (_DEBUG_LOG_BINARY) && !defined (DEBUG_TX_IRQ)
+#error "_DEBUG_LOG_BINARY need DEBUG_TX_IRQ (retarget.c TX ring)"
+#endif
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile unsigned long g_BinLogDropCnt;
+
+#if !defined (_DEBUG_LOG_BINARY)
+#define BINLOG_FMT(name, fmt)                   fmt,
+
+const char * const g_BinLogFmt[BINLOG_ID_NUM] =
+{
+    BINLOG_ID_LIST(BINLOG_FMT)
+};
+#endif
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long BinLog_GetDropCnt(void)
+{
+    return g_BinLogDropCnt;
+}
+
+#if defined (_DEBUG_LOG_BINARY)
+static unsigned char BinLog_Put32(unsigned char *p, unsigned long v)
+{
+    p[0] = (unsigned char)(v);
+    p[1] = (unsigned char)(v >> 8);
+    p[2] = (unsigned char)(v >> 16);
+    p[3] = (unsigned char)(v >> 24);
+
+    return (unsigned char)(p[0] ^ p[1] ^ p[2] ^ p[3]);
+}
+
+int BinLog_Write(unsigned char id, unsigned char nargs,
+                 unsigned long a0, unsigned long a1,
+                 unsigned long a2, unsigned long a3)
+{
+    unsigned char rec[BINLOG_MAX_RECORD];
+    unsigned long args[BINLOG_MAX_ARGS];
+    unsigned char len;
+    unsigned char chk;
+    unsigned char i;
+
+    if (nargs > BINLOG_MAX_ARGS)
+    {
+        nargs = BINLOG_MAX_ARGS;
+    }
+
+    args[0] = a0;
+    args[1] = a1;
+    args[2] = a2;
+    args[3] = a3;
+
+    rec[0] = BINLOG_SYNC;
+    rec[1] = id;
+    rec[2] = nargs;
+    chk    = (unsigned char)(id ^ nargs);
+    chk   ^= BinLog_Put32(&rec[3], TimerService_GetTick());
+    len    = 7U;
+
+    for (i = 0U; i < nargs; i++)
+    {
+        chk ^= BinLog_Put32(&rec[len], args[i]);
+        len  = (unsigned char)(len + 4U);
+    }
+
+    rec[len++] = chk;
+
+    if (DebugTx_WriteRaw(rec, len) != 0)
+    {
+        g_BinLogDropCnt++;
+        return -1;
+    }
+
+    return 0;
+}
+#else
+/* text mode : BLOGn expand to dbg_printf , nothing to record */
+int BinLog_Write(unsigned char id, unsigned char nargs,
+                 unsigned long a0, unsigned long a1,
+                 unsigned long a2, unsigned long a3)
+{
+    (void)id;
+    (void)nargs;
+    (void)a0;
+    (void)a1;
+    (void)a2;
+    (void)a3;
+
+    return -1;
+}
+#endif
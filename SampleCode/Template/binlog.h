@@ -0,0 +1,73 @@
+#ifndef __BINLOG_H__
+#define __BINLOG_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "binlog_id.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * record : SYNC | id | nargs | timestamp (4, LE) | arg (4 x nargs, LE) | xor(id .. last arg)
+ * SYNC is not ASCII, text printf and record can share one UART
+ */
+#define BINLOG_SYNC                             (0xA5U)
+#define BINLOG_MAX_ARGS                         (4U)
+#define BINLOG_MAX_RECORD                       (3U + 4U + (4U * BINLOG_MAX_ARGS) + 1U)
+
+#define BINLOG_ENUM(name, fmt)                  name,
+
+typedef enum
+{
+    BINLOG_ID_LIST(BINLOG_ENUM)
+    BINLOG_ID_NUM
+
+} BINLOG_ID_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#if !defined (_DEBUG_LOG_ENABLE)
+#define BLOG0(id)                               ((void)0)
+#define BLOG1(id, a0)                           ((void)0)
+#define BLOG2(id, a0, a1)                       ((void)0)
+#define BLOG3(id, a0, a1, a2)                   ((void)0)
+#define BLOG4(id, a0, a1, a2, a3)               ((void)0)
+
+#elif defined (_DEBUG_LOG_BINARY)
+/* id + raw argument only, format on host */
+#define BLOG0(id)                               BinLog_Write((id), 0U, 0UL, 0UL, 0UL, 0UL)
+#define BLOG1(id, a0)                           BinLog_Write((id), 1U, (unsigned long)(a0), 0UL, 0UL, 0UL)
+#define BLOG2(id, a0, a1)                       BinLog_Write((id), 2U, (unsigned long)(a0), (unsigned long)(a1), 0UL, 0UL)
+#define BLOG3(id, a0, a1, a2)                   BinLog_Write((id), 3U, (unsigned long)(a0), (unsigned long)(a1), (unsigned long)(a2), 0UL)
+#define BLOG4(id, a0, a1, a2, a3)               BinLog_Write((id), 4U, (unsigned long)(a0), (unsigned long)(a1), (unsigned long)(a2), (unsigned long)(a3))
+
+#else
+/* text fallback, same call site */
+#define BLOG0(id)                               dbg_printf("%s", g_BinLogFmt[(id)])
+#define BLOG1(id, a0)                           dbg_printf(g_BinLogFmt[(id)], (unsigned long)(a0))
+#define BLOG2(id, a0, a1)                       dbg_printf(g_BinLogFmt[(id)], (unsigned long)(a0), (unsigned long)(a1))
+#define BLOG3(id, a0, a1, a2)                   dbg_printf(g_BinLogFmt[(id)], (unsigned long)(a0), (unsigned long)(a1), (unsigned long)(a2))
+#define BLOG4(id, a0, a1, a2, a3)               dbg_printf(g_BinLogFmt[(id)], (unsigned long)(a0), (unsigned long)(a1), (unsigned long)(a2), (unsigned long)(a3))
+
+extern const char * const g_BinLogFmt[BINLOG_ID_NUM];
+#endif
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * ISR safe, never block
+ * return 0  : record queued
+ *        -1 : TX ring full, record dropped
+ */
+int  BinLog_Write(unsigned char id, unsigned char nargs,
+                  unsigned long a0, unsigned long a1,
+                  unsigned long a2, unsigned long a3);
+
+unsigned long BinLog_GetDropCnt(void);
+
+#endif //__BINLOG_H__
@@ -0,0 +1,16 @@
+#ifndef __BINLOG_ID_H__
+#define __BINLOG_ID_H__
+
+/*
+ * binary log format table, shared by firmware (id only) and host decoder (Tools/binlog_decode.c)
+ * argument are sent as 32-bit value : use %lu %ld %lX %c , no %s
+ * append new entry at the end only, id is the position in this list
+ */
+#define BINLOG_ID_LIST(X) \
+    X(BLOG_ID_TASK_1000MS,          "Task_1000ms_Callback:%4lu (1 sec)\r\n")                    \
+    X(BLOG_ID_TIMER_CREATE,         "task%lu id = %ld\r\n")                                     \
+    X(BLOG_ID_KEY_PRESS,            "press : %c\r\n")                                           \
+    X(BLOG_ID_KEY_INVALID,          "invalid command\r\n")                                      \
+    X(BLOG_ID_QUEUE_STATS,          "queue maxused %lu , overflow %lu\r\n")                     \
+
+#endif //__BINLOG_ID_H__
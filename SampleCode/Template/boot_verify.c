@@ -0,0 +1,390 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "boot_verify.h"
+
+#define LOG_MODULE                              LOG_MOD_BOOT
+#include "log.h"
+
+#if defined (ENABLE_BOOT_VERIFY)
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#if defined (__ARMCC_VERSION)
+/* armlink : end of load region , code + RO + RW init data */
+extern unsigned int Load$$LR$$LR_IROM1$$Limit;
+#define BOOT_VERIFY_IMAGE_END                   ((unsigned long)&Load$$LR$$LR_IROM1$$Limit)
+#else
+/* CMSIS gcc_arm.ld : .data load image follow __etext */
+extern unsigned int __etext;
+extern unsigned int __data_start__;
+extern unsigned int __data_end__;
+#define BOOT_VERIFY_IMAGE_END                   ((unsigned long)&__etext + \
+                                                 ((unsigned long)&__data_end__ - (unsigned long)&__data_start__))
+#endif
+
+typedef struct _boot_verify_t
+{
+    const BOOT_VERIFY_TRAILER_T *trailer;   /* 0 : background off */
+    unsigned long                len;
+    unsigned long                pos;       /* background pass progress */
+    unsigned long                step;      /* byte of running chunk */
+    unsigned long                passcnt;
+    unsigned long                failcnt;
+    unsigned long                bootus;
+
+} BOOT_VERIFY_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile BOOT_VERIFY_T g_BootVerify;
+static CRC_SERVICE_CTX_T s_BootVerifyCrc;
+static int g_BootVerifyTimerId = -1;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define BOOT_VERIFY_PTR(off)                    ((const void *)(BOOT_VERIFY_BASE + (off)))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long BootVerify_GetPassCnt(void)
+{
+    return g_BootVerify.passcnt;
+}
+
+unsigned long BootVerify_GetFailCnt(void)
+{
+    return g_BootVerify.failcnt;
+}
+
+unsigned long BootVerify_GetBootUs(void)
+{
+    return g_BootVerify.bootus;
+}
+
+static unsigned long BootVerify_CycleToUs(unsigned long cyc)
+{
+    return cyc / (SystemCoreClock / 1000000UL);
+}
+
+/* padded image length */
+static unsigned long BootVerify_ImageLen(void)
+{
+    return (BOOT_VERIFY_IMAGE_END - BOOT_VERIFY_BASE + BOOT_VERIFY_ALIGN - 1UL) & ~(BOOT_VERIFY_ALIGN - 1UL);
+}
+
+/* LDROM hold a vector table : initial SP in SRAM , reset handler inside LDROM (thumb) */
+static int BootVerify_LdromValid(void)
+{
+    unsigned long sp;
+    unsigned long pc;
+
+    sp = FMC_Read(FMC_LDROM_BASE);
+    pc = FMC_Read(FMC_LDROM_BASE + 4UL);
+
+    return ((sp > 0x20000000UL) && (sp <= BOOT_VERIFY_SRAM_END) && ((sp & 3UL) == 0UL) &&
+            (pc > FMC_LDROM_BASE) && (pc < (FMC_LDROM_BASE + BOOT_VERIFY_LDROM_SIZE)) && (pc & 1UL)) ? 1 : 0;
+}
+
+__WEAK void BootVerify_OnFail(unsigned char where)
+{
+    LOG_E("image corrupt (%s) , stop\r\n", (where == BOOT_VERIFY_AT_BOOT) ? "boot" : "background");
+
+    __disable_irq();
+
+    /* log ring poll out with interrupt off */
+    #if defined (DEBUG_TX_IRQ)
+    DebugTx_Flush();
+    #endif
+
+    SYS_UnlockReg();
+    FMC_Open();
+
+    /* ISP in LDROM : boot it , BS kept over system reset */
+    if (BootVerify_LdromValid())
+    {
+        FMC_SET_LDROM_BOOT();
+        NVIC_SystemReset();
+    }
+
+    /* nothing to fall back on , never run corrupt code further */
+    while (1)
+    {
+    }
+}
+
+/* return BOOT_VERIFY_OK , BOOT_VERIFY_NO_TRAILER , BOOT_VERIFY_FAIL (trailer of other build) */
+static int BootVerify_GetTrailer(const BOOT_VERIFY_TRAILER_T **trailer)
+{
+    const BOOT_VERIFY_TRAILER_T *t;
+    unsigned long len;
+
+    len = BootVerify_ImageLen();
+
+    if ((len + sizeof(BOOT_VERIFY_TRAILER_T)) > BOOT_VERIFY_APROM_SIZE)
+    {
+        return BOOT_VERIFY_NO_TRAILER;
+    }
+
+    t = (const BOOT_VERIFY_TRAILER_T *)BOOT_VERIFY_PTR(len);
+
+    /* erased flash : all 0xFF , never a valid pair */
+    if ((t->magic != BOOT_VERIFY_MAGIC) || (t->check != ~t->crc))
+    {
+        return BOOT_VERIFY_NO_TRAILER;
+    }
+
+    if (t->length != len)
+    {
+        return BOOT_VERIFY_FAIL;
+    }
+
+    *trailer = t;
+
+    return BOOT_VERIFY_OK;
+}
+
+int BootVerify_Boot(void)
+{
+    volatile BOOT_VERIFY_T *v;
+    const BOOT_VERIFY_TRAILER_T *t = (const BOOT_VERIFY_TRAILER_T *)0;
+    unsigned long start;
+    unsigned long crc;
+    unsigned long len;
+    int ret;
+
+    v = &g_BootVerify;
+
+    ret = BootVerify_GetTrailer(&t);
+    if (ret == BOOT_VERIFY_NO_TRAILER)
+    {
+        LOG_W("no image trailer , check skipped\r\n");
+        return ret;
+    }
+    else if (ret != BOOT_VERIFY_OK)
+    {
+        LOG_E("trailer length mismatch\r\n");
+        BootVerify_OnFail(BOOT_VERIFY_AT_BOOT);
+        return ret;
+    }
+
+    len   = t->length;
+    start = get_systick_cycle();
+
+    CrcService_CtxInit(&s_BootVerifyCrc, CRC_SERVICE_CRC32);
+    if (CrcService_Update(&s_BootVerifyCrc, BOOT_VERIFY_PTR(0UL), len) != 0)
+    {
+        LOG_E("crc engine busy\r\n");
+        return BOOT_VERIFY_BUSY;
+    }
+    crc = CrcService_Final(&s_BootVerifyCrc);
+
+    v->bootus = BootVerify_CycleToUs(get_systick_cycle() - start);
+
+    if (crc != t->crc)
+    {
+        LOG_E("image crc %08lX , trailer %08lX\r\n", crc, (unsigned long)t->crc);
+        BootVerify_OnFail(BOOT_VERIFY_AT_BOOT);
+        return BOOT_VERIFY_FAIL;
+    }
+
+    LOG_I("image %lu byte , crc %08lX ok , %lu us\r\n", len, crc, v->bootus);
+
+    return BOOT_VERIFY_OK;
+}
+
+/* chunk done , TimerService_Dispatch */
+static void BootVerify_Advance(int status)
+{
+    volatile BOOT_VERIFY_T *v;
+    unsigned long crc;
+
+    v = &g_BootVerify;
+
+    if ((status != PDMA_SERVICE_OK) || (v->trailer == (const BOOT_VERIFY_TRAILER_T *)0))
+    {
+        v->pos = 0UL;       /* restart pass */
+        return;
+    }
+
+    v->pos += v->step;
+    if (v->pos < v->len)
+    {
+        return;
+    }
+
+    v->pos = 0UL;
+    crc = CrcService_Final(&s_BootVerifyCrc);
+
+    if (crc == v->trailer->crc)
+    {
+        v->passcnt++;
+    }
+    else
+    {
+        v->failcnt++;
+        LOG_E("background crc %08lX , trailer %08lX\r\n", crc, (unsigned long)v->trailer->crc);
+        BootVerify_OnFail(BOOT_VERIFY_AT_BACKGROUND);
+    }
+}
+
+static void BootVerify_StepDone(int status, void *user_data)
+{
+    (void)user_data;
+
+    BootVerify_Advance(status);
+}
+
+/* background timer , TimerService_Dispatch */
+static void BootVerify_Step(void *user_data)
+{
+    volatile BOOT_VERIFY_T *v;
+    unsigned long n;
+    int ret;
+
+    (void)user_data;
+
+    v = &g_BootVerify;
+
+    /* off , or previous chunk still in PDMA */
+    if ((v->trailer == (const BOOT_VERIFY_TRAILER_T *)0) || CrcService_IsBusy(&s_BootVerifyCrc))
+    {
+        return;
+    }
+
+    if (v->pos == 0UL)
+    {
+        CrcService_Reset(&s_BootVerifyCrc);
+    }
+
+    n = v->len - v->pos;
+    if (n > BOOT_VERIFY_BG_CHUNK)
+    {
+        n = BOOT_VERIFY_BG_CHUNK;
+    }
+
+    ret = CrcService_UpdateAsync(&s_BootVerifyCrc, BOOT_VERIFY_PTR(v->pos), n, BootVerify_StepDone, (void *)0);
+    if (ret < 0)
+    {
+        return;             /* engine used by other stream : next period */
+    }
+
+    v->step = n;
+
+    if (ret == CRC_SERVICE_ASYNC_DONE)
+    {
+        BootVerify_Advance(PDMA_SERVICE_OK);
+    }
+}
+
+void BootVerify_StopBackground(void)
+{
+    if (g_BootVerifyTimerId >= 0)
+    {
+        TimerService_StopTimer((unsigned int)g_BootVerifyTimerId);
+    }
+
+    /* running chunk still complete , result dropped by BootVerify_Advance */
+    g_BootVerify.trailer = (const BOOT_VERIFY_TRAILER_T *)0;
+}
+
+int BootVerify_StartBackground(unsigned short period_ms)
+{
+    volatile BOOT_VERIFY_T *v;
+    const BOOT_VERIFY_TRAILER_T *t = (const BOOT_VERIFY_TRAILER_T *)0;
+
+    v = &g_BootVerify;
+
+    if ((period_ms == 0U) || (BootVerify_GetTrailer(&t) != BOOT_VERIFY_OK) || CrcService_IsBusy(&s_BootVerifyCrc))
+    {
+        return -1;
+    }
+
+    BootVerify_StopBackground();
+
+    if (g_BootVerifyTimerId < 0)
+    {
+        g_BootVerifyTimerId = TimerService_CreateTimerQueue(period_ms, BootVerify_Step, (void *)0);
+        if (g_BootVerifyTimerId < 0)
+        {
+            return -1;
+        }
+    }
+    else
+    {
+        TimerService_ChangePeriod((unsigned int)g_BootVerifyTimerId, period_ms);
+    }
+
+    CrcService_CtxInit(&s_BootVerifyCrc, CRC_SERVICE_CRC32);
+
+    v->len     = t->length;
+    v->pos     = 0UL;
+    v->step    = 0UL;
+    v->trailer = t;
+
+    TimerService_StartTimer((unsigned int)g_BootVerifyTimerId);
+
+    return 0;
+}
+
+void BootVerify_Compare(void)
+{
+    const BOOT_VERIFY_TRAILER_T *t = (const BOOT_VERIFY_TRAILER_T *)0;
+    CRC_SERVICE_CTX_T ctx;
+    unsigned long len;
+    unsigned long t0;
+    unsigned long t1;
+    unsigned long t2;
+    unsigned long t3;
+    unsigned long crc;
+    unsigned long fmc;
+    uint32_t locked;
+    int ret;
+
+    ret = BootVerify_GetTrailer(&t);
+    len = BootVerify_ImageLen();
+
+    t0 = get_systick_cycle();
+    CrcService_CtxInit(&ctx, CRC_SERVICE_CRC32);
+    if (CrcService_Update(&ctx, BOOT_VERIFY_PTR(0UL), len) != 0)
+    {
+        dbg_printf("crc engine busy , try again\r\n");
+        return;
+    }
+    crc = CrcService_Final(&ctx);
+    t1 = get_systick_cycle();
+
+    locked = SYS_IsRegLocked();
+    SYS_UnlockReg();
+    FMC_Open();
+
+    t2  = get_systick_cycle();
+    fmc = FMC_GetChkSum(BOOT_VERIFY_BASE, len);
+    t3  = get_systick_cycle();
+
+    FMC_Close();
+    if (locked)
+    {
+        SYS_LockReg();
+    }
+
+    dbg_printf("image      : %lu byte , boot check %lu us\r\n", len, g_BootVerify.bootus);
+    dbg_printf("crc + pdma : %08lX , %lu us\r\n", crc, BootVerify_CycleToUs(t1 - t0));
+    dbg_printf("fmc chksum : %08lX , %lu us , %s\r\n", fmc, BootVerify_CycleToUs(t3 - t2),
+               (fmc == crc) ? "same as crc" : "other algorithm");
+
+    if (ret == BOOT_VERIFY_OK)
+    {
+        dbg_printf("trailer    : %08lX , %s\r\n", (unsigned long)t->crc, (crc == t->crc) ? "ok" : "FAIL");
+    }
+    else
+    {
+        dbg_printf("trailer    : %s\r\n", (ret == BOOT_VERIFY_NO_TRAILER) ? "none" : "length mismatch");
+    }
+
+    dbg_printf("background : pass %lu , fail %lu\r\n", g_BootVerify.passcnt, g_BootVerify.failcnt);
+}
+
+#endif
@@ -0,0 +1,84 @@
+#ifndef __BOOT_VERIFY_H__
+#define __BOOT_VERIFY_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+#include "crc_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * APROM image integrity
+ *
+ * image   : APROM base to linker load region end , padded with 0xFF to BOOT_VERIFY_ALIGN
+ *           (FMC checksum unit) , BOOT_VERIFY_TRAILER_T right after the padding
+ * trailer : added to obj\Template.bin after fromelf by Tools/boot_trailer.c
+ *           image without trailer (debugger download) : BOOT_VERIFY_NO_TRAILER , check skipped
+ * boot    : CRC-32 over padded image , crc_service.c PDMA feed , time in log and BootVerify_GetBootUs
+ * runtime : BootVerify_StartBackground , BOOT_VERIFY_BG_CHUNK byte per TimerService period ,
+ *           CrcService_UpdateAsync , full pass compared with trailer
+ * compare : BootVerify_Compare time CRC + PDMA against FMC_GetChkSum over the same range
+ * fail    : BootVerify_OnFail on boot and background mismatch , weak default boot LDROM (ISP) if it hold
+ *           an image , else stop in a loop with interrupt off , override for product policy
+ */
+#define BOOT_VERIFY_BASE                        (FMC_APROM_BASE)
+#define BOOT_VERIFY_APROM_SIZE                  (0x20000UL)     /* 128 KB , IROM of project */
+#define BOOT_VERIFY_ALIGN                       (512UL)
+#define BOOT_VERIFY_MAGIC                       (0x31545642UL)  /* "BVT1" */
+
+#define BOOT_VERIFY_BG_CHUNK                    (1024UL)        /* byte per background step */
+#define BOOT_VERIFY_BG_PERIOD_MS                (10U)           /* 128 KB pass in 1.3 s */
+
+/* result */
+#define BOOT_VERIFY_OK                          (0)
+#define BOOT_VERIFY_NO_TRAILER                  (1)
+#define BOOT_VERIFY_FAIL                        (-1)
+#define BOOT_VERIFY_BUSY                        (-2)            /* CRC engine in use */
+
+/* BootVerify_OnFail where */
+#define BOOT_VERIFY_AT_BOOT                     (0U)
+#define BOOT_VERIFY_AT_BACKGROUND               (1U)
+
+#define BOOT_VERIFY_SRAM_END                    (0x20004000UL)  /* 16 KB , LDROM stack pointer check */
+#define BOOT_VERIFY_LDROM_SIZE                  (0x1000UL)      /* 4 KB , LDROM reset handler check */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* little endian , word aligned in flash */
+typedef struct _boot_verify_trailer_t
+{
+    uint32_t        magic;
+    uint32_t        length;     /* padded image byte , multiple of BOOT_VERIFY_ALIGN */
+    uint32_t        crc;        /* CRC-32 IEEE of padded image */
+    uint32_t        check;      /* ~crc */
+
+} BOOT_VERIFY_TRAILER_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after CrcService_Init , SysTick running , return BOOT_VERIFY_x , result and time to log */
+int  BootVerify_Boot(void);
+
+/* return 0 , -1 if no valid trailer or no timer */
+int  BootVerify_StartBackground(unsigned short period_ms);
+void BootVerify_StopBackground(void);
+
+unsigned long BootVerify_GetPassCnt(void);
+unsigned long BootVerify_GetFailCnt(void);
+unsigned long BootVerify_GetBootUs(void);
+
+/*
+ * image mismatch , called once from BootVerify_Boot (main) or background check (TimerService_Dispatch)
+ * weak , default never return
+ */
+void BootVerify_OnFail(unsigned char where);
+
+/* shell : CRC + PDMA vs FMC_GetChkSum , time and result , print to debug UART */
+void BootVerify_Compare(void);
+
+#endif //__BOOT_VERIFY_H__
@@ -0,0 +1,407 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "crc_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _crc_service_t
+{
+    CRC_SERVICE_CTX_T     *owner;       /* context in engine , 0 : engine content not needed */
+    CRC_SERVICE_CTX_T     *async;       /* context of running async feed */
+    const unsigned char   *tail;        /* async : byte after word part */
+    unsigned long          lostcnt;
+    unsigned char          tlen;
+    unsigned char          lock;        /* engine in use */
+    unsigned char          dmadone;     /* sync feed : hook event */
+    signed char            ch;          /* -1 : no PDMA channel */
+
+} CRC_SERVICE_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile CRC_SERVICE_T g_CrcService;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define CRC_SERVICE_ENTER_CRITICAL(m)           do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define CRC_SERVICE_EXIT_CRITICAL(m)            __set_PRIMASK(m)
+
+/* engine run raw (no checksum format) , data length per write */
+#define CRC_SERVICE_SET_LEN(ctx, len)           (CRC->CTL = (ctx)->ctl | (len) | CRC_CTL_CRCEN_Msk)
+
+#define CRC_SERVICE_ADDR(p)                     ((unsigned long)(p))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+int CrcService_GetChannel(void)
+{
+    return g_CrcService.ch;
+}
+
+unsigned long CrcService_GetLostCnt(void)
+{
+    return g_CrcService.lostcnt;
+}
+
+static unsigned char CrcService_Width(unsigned long ctl)
+{
+    switch (ctl & CRC_CTL_CRCMODE_Msk)
+    {
+        case CRC_8:     return 8U;
+        case CRC_32:    return 32U;
+        default:        return 16U;     /* CRC_CCITT , CRC_16 */
+    }
+}
+
+static unsigned long CrcService_Mask(unsigned long ctl)
+{
+    unsigned char w = CrcService_Width(ctl);
+
+    return (w == 32U) ? 0xFFFFFFFFUL : ((1UL << w) - 1UL);
+}
+
+static int CrcService_Lock(void)
+{
+    volatile CRC_SERVICE_T *s;
+    uint32_t primask;
+    int ret = -1;
+
+    s = &g_CrcService;
+
+    CRC_SERVICE_ENTER_CRITICAL(primask);
+    if (s->lock == 0U)
+    {
+        s->lock = 1U;
+        ret = 0;
+    }
+    CRC_SERVICE_EXIT_CRITICAL(primask);
+
+    return ret;
+}
+
+/* lock held , save running checksum of previous owner , load ctx */
+static void CrcService_Load(CRC_SERVICE_CTX_T *ctx)
+{
+    volatile CRC_SERVICE_T *s;
+    s = &g_CrcService;
+
+    if (s->owner == ctx)
+    {
+        return;
+    }
+
+    if (s->owner != (CRC_SERVICE_CTX_T *)0)
+    {
+        s->owner->state = CRC->CHECKSUM & CrcService_Mask(s->owner->ctl);
+    }
+
+    CRC_SERVICE_SET_LEN(ctx, CRC_WDATA_8);
+    CRC_SET_SEED(ctx->state);
+
+    s->owner = ctx;
+}
+
+/* lock held , ctx loaded */
+static const unsigned char *CrcService_Bytes(CRC_SERVICE_CTX_T *ctx, const unsigned char *p, unsigned long n)
+{
+    CRC_SERVICE_SET_LEN(ctx, CRC_WDATA_8);
+
+    while (n--)
+    {
+        CRC_WRITE_DATA(*p++);
+    }
+
+    return p;
+}
+
+static void CrcService_Words(CRC_SERVICE_CTX_T *ctx, const uint32_t *p, unsigned long n)
+{
+    CRC_SERVICE_SET_LEN(ctx, CRC_WDATA_32);
+
+    while (n >= 4UL)
+    {
+        CRC_WRITE_DATA(p[0]);
+        CRC_WRITE_DATA(p[1]);
+        CRC_WRITE_DATA(p[2]);
+        CRC_WRITE_DATA(p[3]);
+        p += 4;
+        n -= 4UL;
+    }
+
+    while (n--)
+    {
+        CRC_WRITE_DATA(*p++);
+    }
+}
+
+/* memory to CRC_DAT , 32 bit , engine already in 32 bit data length */
+static void CrcService_DmaStart(const uint32_t *p, unsigned long n)
+{
+    unsigned char ch = (unsigned char)g_CrcService.ch;
+
+    PDMA->CHCTL |= (1UL << ch);
+    PDMA_SetTransferCnt(PDMA, ch, PDMA_WIDTH_32, n);
+    PDMA_SetTransferAddr(PDMA, ch, (uint32_t)p, PDMA_SAR_INC, (uint32_t)&CRC->DAT, PDMA_DAR_FIX);
+    PDMA_SetTransferMode(PDMA, ch, PDMA_MEM, FALSE, 0);
+    PDMA_SetBurstType(PDMA, ch, PDMA_REQ_BURST, CRC_SERVICE_DMA_BURST);
+    PDMA_EnableInt(PDMA, ch, PDMA_INT_TRANS_DONE);
+    PDMA_Trigger(PDMA, ch);
+}
+
+/* async done , run in TimerService_Dispatch */
+static void CrcService_Complete(void *user_data)
+{
+    CRC_SERVICE_CTX_T *ctx = (CRC_SERVICE_CTX_T *)user_data;
+
+    ctx->busy = 0U;
+
+    if (ctx->callback != (CRC_SERVICE_CALLBACK_T)0)
+    {
+        ctx->callback(ctx->status, ctx->user_data);
+    }
+}
+
+/* PDMA IRQ */
+static void CrcService_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    volatile CRC_SERVICE_T *s;
+    CRC_SERVICE_CTX_T *ctx;
+
+    (void)ch;
+    (void)user_data;
+
+    s = &g_CrcService;
+    ctx = s->async;
+
+    if (ctx == (CRC_SERVICE_CTX_T *)0)
+    {
+        s->dmadone = event;     /* sync feed wait on it */
+        return;
+    }
+
+    s->async = (CRC_SERVICE_CTX_T *)0;
+
+    if (event & PDMA_SERVICE_EVT_DONE)
+    {
+        (void)CrcService_Bytes(ctx, s->tail, s->tlen);
+        ctx->status = PDMA_SERVICE_OK;
+    }
+    else
+    {
+        ctx->status = PDMA_SERVICE_ABORT;
+    }
+
+    s->lock = 0U;
+
+    if (TimerService_Post(CrcService_Complete, (void *)ctx) != 0)
+    {
+        ctx->busy = 0U;
+        s->lostcnt++;
+    }
+}
+
+int CrcService_Update(CRC_SERVICE_CTX_T *ctx, const void *buf, unsigned long len)
+{
+    volatile CRC_SERVICE_T *s;
+    const unsigned char *p;
+    unsigned long head;
+    unsigned long n;
+    unsigned long chunk;
+    int ret = 0;
+
+    s = &g_CrcService;
+
+    if (CrcService_Lock() != 0)
+    {
+        return -1;
+    }
+
+    CrcService_Load(ctx);
+
+    p = (const unsigned char *)buf;
+
+    head = (0UL - CRC_SERVICE_ADDR(p)) & 3UL;
+    if (head > len)
+    {
+        head = len;
+    }
+
+    p    = CrcService_Bytes(ctx, p, head);
+    len -= head;
+    n    = len >> 2;
+
+    if ((s->ch >= 0) && ((n << 2) >= CRC_SERVICE_DMA_THRESHOLD))
+    {
+        CRC_SERVICE_SET_LEN(ctx, CRC_WDATA_32);
+
+        while (n != 0UL)
+        {
+            chunk = (n > CRC_SERVICE_DMA_MAX) ? CRC_SERVICE_DMA_MAX : n;
+
+            s->dmadone = 0U;
+            CrcService_DmaStart((const uint32_t *)p, chunk);
+
+            while (s->dmadone == 0U)
+            {
+            }
+
+            if ((s->dmadone & PDMA_SERVICE_EVT_DONE) == 0U)
+            {
+                ret = -1;
+                break;
+            }
+
+            p += chunk << 2;
+            n -= chunk;
+        }
+    }
+    else if (n != 0UL)
+    {
+        CrcService_Words(ctx, (const uint32_t *)p, n);
+        p += n << 2;
+    }
+
+    if (ret == 0)
+    {
+        (void)CrcService_Bytes(ctx, p, len & 3UL);
+    }
+
+    s->lock = 0U;
+
+    return ret;
+}
+
+int CrcService_UpdateAsync(CRC_SERVICE_CTX_T *ctx, const void *buf, unsigned long len,
+                           CRC_SERVICE_CALLBACK_T callback, void *user_data)
+{
+    volatile CRC_SERVICE_T *s;
+    const unsigned char *p;
+    unsigned long head;
+    unsigned long n;
+
+    s = &g_CrcService;
+
+    if ((ctx->busy != 0U) || ((len >> 2) > CRC_SERVICE_DMA_MAX))
+    {
+        return -1;
+    }
+
+    if (CrcService_Lock() != 0)
+    {
+        return -1;
+    }
+
+    CrcService_Load(ctx);
+
+    p = (const unsigned char *)buf;
+
+    head = (0UL - CRC_SERVICE_ADDR(p)) & 3UL;
+    if (head > len)
+    {
+        head = len;
+    }
+
+    p    = CrcService_Bytes(ctx, p, head);
+    len -= head;
+    n    = len >> 2;
+
+    /* short or no channel : whole on CPU now */
+    if ((s->ch < 0) || ((n << 2) < CRC_SERVICE_DMA_THRESHOLD))
+    {
+        CrcService_Words(ctx, (const uint32_t *)p, n);
+        (void)CrcService_Bytes(ctx, p + (n << 2), len & 3UL);
+
+        s->lock = 0U;
+
+        return CRC_SERVICE_ASYNC_DONE;
+    }
+
+    ctx->callback  = callback;
+    ctx->user_data = user_data;
+    ctx->status    = PDMA_SERVICE_OK;
+    ctx->busy      = 1U;
+
+    s->tail  = p + (n << 2);
+    s->tlen  = (unsigned char)(len & 3UL);
+    s->async = ctx;
+
+    CRC_SERVICE_SET_LEN(ctx, CRC_WDATA_32);
+    CrcService_DmaStart((const uint32_t *)p, n);
+
+    return CRC_SERVICE_ASYNC_QUEUED;
+}
+
+unsigned long CrcService_Final(CRC_SERVICE_CTX_T *ctx)
+{
+    unsigned long raw;
+    unsigned long mask;
+    unsigned long r;
+    unsigned char w;
+    unsigned char i;
+
+    raw  = (g_CrcService.owner == ctx) ? CRC->CHECKSUM : ctx->state;
+    mask = CrcService_Mask(ctx->ctl);
+    raw &= mask;
+
+    if (ctx->fmt & CRC_CHECKSUM_RVS)
+    {
+        w = CrcService_Width(ctx->ctl);
+
+        for (r = 0UL, i = 0U; i < w; i++)
+        {
+            r   = (r << 1) | (raw & 1UL);
+            raw >>= 1;
+        }
+
+        raw = r;
+    }
+
+    if (ctx->fmt & CRC_CHECKSUM_COM)
+    {
+        raw ^= mask;
+    }
+
+    return raw;
+}
+
+void CrcService_Reset(CRC_SERVICE_CTX_T *ctx)
+{
+    ctx->state = ctx->seed & CrcService_Mask(ctx->ctl);
+
+    /* engine content of ctx is stale now : reload on next use */
+    if (g_CrcService.owner == ctx)
+    {
+        g_CrcService.owner = (CRC_SERVICE_CTX_T *)0;
+    }
+}
+
+void CrcService_CtxInit(CRC_SERVICE_CTX_T *ctx, unsigned long mode, unsigned long attribute, unsigned long seed)
+{
+    ctx->ctl       = (mode & CRC_CTL_CRCMODE_Msk) | (attribute & (CRC_WDATA_RVS | CRC_WDATA_COM));
+    ctx->fmt       = attribute & (CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM);
+    ctx->seed      = seed;
+    ctx->callback  = (CRC_SERVICE_CALLBACK_T)0;
+    ctx->user_data = (void *)0;
+    ctx->busy      = 0U;
+    ctx->status    = PDMA_SERVICE_OK;
+
+    CrcService_Reset(ctx);
+}
+
+void CrcService_Init(void)
+{
+    volatile CRC_SERVICE_T *s;
+    int ch;
+
+    s = &g_CrcService;
+    s->owner   = (CRC_SERVICE_CTX_T *)0;
+    s->async   = (CRC_SERVICE_CTX_T *)0;
+    s->lostcnt = 0UL;
+    s->lock    = 0U;
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, CrcService_PdmaHook, (void *)0);
+    s->ch = (signed char)ch;
+}
@@ -0,0 +1,91 @@
+#ifndef __CRC_SERVICE_H__
+#define __CRC_SERVICE_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+#include "pdma_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * one CRC engine shared by several stream , each stream is a caller owned context
+ *
+ * context : mode / data attribute / seed , running checksum saved in context while other context use
+ *           the engine (CHECKSUM raw read , reload by SEED + CHKSINIT) , switch only when owner change
+ * feed    : byte to word boundary , word (32 bit write , byte 0 first) , byte tail
+ *           word part >= CRC_SERVICE_DMA_THRESHOLD by PDMA memory to CRC_DAT , else CPU
+ * output  : CRC_CHECKSUM_RVS / CRC_CHECKSUM_COM applied by CrcService_Final , engine run raw
+ *
+ * thread / TimerService_Dispatch context , not ISR
+ * engine busy (async feed running , or other caller inside CrcService_Update) : return -1 , retry later
+ */
+#define CRC_SERVICE_DMA_THRESHOLD               (64U)       /* byte , below : PDMA setup + IRQ cost more than CPU write */
+#define CRC_SERVICE_DMA_MAX                     (65536UL)   /* word per PDMA transfer */
+#define CRC_SERVICE_DMA_BURST                   (PDMA_BURST_16)
+
+/* CrcService_UpdateAsync return */
+#define CRC_SERVICE_ASYNC_QUEUED                (0)         /* callback later */
+#define CRC_SERVICE_ASYNC_DONE                  (1)         /* done by CPU , no callback */
+
+/* CrcService_CtxInit preset : mode , attribute , seed */
+#define CRC_SERVICE_CRC32                       CRC_32, (CRC_WDATA_RVS | CRC_CHECKSUM_RVS | CRC_CHECKSUM_COM), 0xFFFFFFFFUL
+#define CRC_SERVICE_CCITT_FALSE                 CRC_CCITT, 0UL, 0xFFFFUL
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* status is PDMA_SERVICE_OK or PDMA_SERVICE_ABORT , run in TimerService_Dispatch */
+typedef void (*CRC_SERVICE_CALLBACK_T)(int status, void *user_data);
+
+/* caller owned , never copy while in use */
+typedef struct _crc_service_ctx_t
+{
+    unsigned long            ctl;       /* CRC_x mode | CRC_WDATA_RVS / CRC_WDATA_COM */
+    unsigned long            fmt;       /* CRC_CHECKSUM_RVS / CRC_CHECKSUM_COM */
+    unsigned long            seed;
+    unsigned long            state;     /* raw checksum , valid while not in engine */
+    CRC_SERVICE_CALLBACK_T   callback;
+    void                    *user_data;
+    volatile unsigned char   busy;      /* async feed running */
+    volatile signed char     status;
+    unsigned char            reserved[2];
+
+} CRC_SERVICE_CTX_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define CrcService_IsBusy(ctx)                  ((ctx)->busy != 0U)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* CRC clock enabled in SYS_Init , call after PdmaService_Init , no channel left : CPU feed only */
+void CrcService_Init(void);
+
+/* mode CRC_x , attribute CRC_WDATA_x | CRC_CHECKSUM_x , data length is chosen per write */
+void CrcService_CtxInit(CRC_SERVICE_CTX_T *ctx, unsigned long mode, unsigned long attribute, unsigned long seed);
+
+/* restart from seed */
+void CrcService_Reset(CRC_SERVICE_CTX_T *ctx);
+
+/* add len byte , return 0 , -1 if engine busy */
+int  CrcService_Update(CRC_SERVICE_CTX_T *ctx, const void *buf, unsigned long len);
+
+/*
+ * add len byte , word part by PDMA , buf must stay valid until callback
+ * len up to CRC_SERVICE_DMA_MAX word
+ * return CRC_SERVICE_ASYNC_QUEUED , CRC_SERVICE_ASYNC_DONE , -1 if engine busy or len too long
+ * callback lost if TimerService post queue full (CrcService_GetLostCnt) , CrcService_IsBusy still clear
+ */
+int  CrcService_UpdateAsync(CRC_SERVICE_CTX_T *ctx, const void *buf, unsigned long len,
+                            CRC_SERVICE_CALLBACK_T callback, void *user_data);
+
+/* checksum so far with output format , context may continue , not while busy */
+unsigned long CrcService_Final(CRC_SERVICE_CTX_T *ctx);
+
+/* -1 : CPU only */
+int  CrcService_GetChannel(void);
+unsigned long CrcService_GetLostCnt(void);
+
+#endif //__CRC_SERVICE_H__
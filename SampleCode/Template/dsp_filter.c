@@ -0,0 +1,365 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdint.h>
+
+#if !defined (DSP_FILTER_HOST)
+#include "NuMicro.h"
+#include "misc_config.h"
+#endif
+
+#include "dsp_filter.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define DSP_FILTER_SAT16(v)                     (((v) > 32767L) ? 32767 : (((v) < -32768L) ? -32768 : (v)))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+int DspFilter_MaInit(DSP_MA_T *f, unsigned char shift)
+{
+    unsigned int i;
+
+    if (shift > DSP_FILTER_MA_MAX_SHIFT)
+    {
+        return -1;
+    }
+
+    for (i = 0U; i < (1U << DSP_FILTER_MA_MAX_SHIFT); i++)
+    {
+        f->hist[i] = 0;
+    }
+
+    f->sum   = 0L;
+    f->pos   = 0U;
+    f->shift = shift;
+
+    return 0;
+}
+
+void DspFilter_Ma(DSP_MA_T *f, const int16_t *in, int16_t *out, unsigned int n)
+{
+    int32_t sum;
+    unsigned int pos;
+    unsigned int mask;
+    unsigned int shift;
+    int16_t x;
+
+    /* state in register for the whole block */
+    sum   = f->sum;
+    pos   = f->pos;
+    shift = f->shift;
+    mask  = (1U << shift) - 1U;
+
+    while (n--)
+    {
+        x = *in++;
+        sum += (int32_t)x - (int32_t)f->hist[pos];
+        f->hist[pos] = x;
+        pos = (pos + 1U) & mask;
+        *out++ = (int16_t)(sum >> shift);
+    }
+
+    f->sum = sum;
+    f->pos = (uint16_t)pos;
+}
+
+int DspFilter_CicInit(DSP_CIC_T *f, unsigned char order, unsigned char rshift)
+{
+    unsigned int i;
+
+    if ((order == 0U) || (order > DSP_FILTER_CIC_MAX_ORDER) || (rshift == 0U) || ((order * rshift) > 16U))
+    {
+        return -1;
+    }
+
+    for (i = 0U; i < DSP_FILTER_CIC_MAX_ORDER; i++)
+    {
+        f->integ[i] = 0UL;
+        f->comb[i]  = 0UL;
+    }
+
+    f->phase  = 0U;
+    f->order  = order;
+    f->rshift = rshift;
+
+    return 0;
+}
+
+unsigned int DspFilter_Cic(DSP_CIC_T *f, const int16_t *in, int16_t *out, unsigned int n)
+{
+    uint32_t i0;
+    uint32_t i1;
+    uint32_t i2;
+    uint32_t v;
+    uint32_t t;
+    unsigned int phase;
+    unsigned int r;
+    unsigned int k;
+    unsigned int cnt;
+
+    i0    = f->integ[0];
+    i1    = f->integ[1];
+    i2    = f->integ[2];
+    phase = f->phase;
+    r     = 1U << f->rshift;
+    cnt   = 0U;
+
+    while (n--)
+    {
+        /* integrator at input rate , stage above order also run : cheaper than branch , never read */
+        i0 += (uint32_t)(int32_t)*in++;
+        i1 += i0;
+        i2 += i1;
+
+        if (++phase < r)
+        {
+            continue;
+        }
+        phase = 0U;
+
+        /* comb at output rate */
+        v = (f->order == 1U) ? i0 : ((f->order == 2U) ? i1 : i2);
+
+        for (k = 0U; k < f->order; k++)
+        {
+            t = v;
+            v = v - f->comb[k];
+            f->comb[k] = t;
+        }
+
+        out[cnt++] = (int16_t)((int32_t)v >> (f->order * f->rshift));
+    }
+
+    f->integ[0] = i0;
+    f->integ[1] = i1;
+    f->integ[2] = i2;
+    f->phase    = (uint16_t)phase;
+
+    return cnt;
+}
+
+int DspFilter_BiquadInit(DSP_BIQUAD_T *f, const int16_t *coef, unsigned char stages)
+{
+    unsigned int s;
+    unsigned int k;
+
+    if ((coef == (const int16_t *)0) || (stages == 0U) || (stages > DSP_FILTER_BIQUAD_MAX_STAGE))
+    {
+        return -1;
+    }
+
+    for (s = 0U; s < DSP_FILTER_BIQUAD_MAX_STAGE; s++)
+    {
+        for (k = 0U; k < 4U; k++)
+        {
+            f->state[s][k] = 0;
+        }
+    }
+
+    f->coef   = coef;
+    f->stages = stages;
+
+    return 0;
+}
+
+void DspFilter_Biquad(DSP_BIQUAD_T *f, const int16_t *in, int16_t *out, unsigned int n)
+{
+    const int16_t *c;
+    int32_t b0;
+    int32_t b1;
+    int32_t b2;
+    int32_t a1;
+    int32_t a2;
+    int32_t x1;
+    int32_t x2;
+    int32_t y1;
+    int32_t y2;
+    int32_t x;
+    int32_t acc;
+    unsigned int s;
+    unsigned int i;
+
+    /* stage by stage over whole block : coefficient and state stay in register */
+    for (s = 0U; s < f->stages; s++)
+    {
+        c  = &f->coef[s * 5U];
+        b0 = c[0];
+        b1 = c[1];
+        b2 = c[2];
+        a1 = c[3];
+        a2 = c[4];
+
+        x1 = f->state[s][0];
+        x2 = f->state[s][1];
+        y1 = f->state[s][2];
+        y2 = f->state[s][3];
+
+        for (i = 0U; i < n; i++)
+        {
+            x   = in[i];
+            acc = (b0 * x) + (b1 * x1) + (b2 * x2) - (a1 * y1) - (a2 * y2);
+            acc = (acc + (1L << 13)) >> 14;
+            acc = DSP_FILTER_SAT16(acc);
+
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = acc;
+            out[i] = (int16_t)acc;
+        }
+
+        f->state[s][0] = (int16_t)x1;
+        f->state[s][1] = (int16_t)x2;
+        f->state[s][2] = (int16_t)y1;
+        f->state[s][3] = (int16_t)y2;
+
+        in = out;
+    }
+}
+
+int DspFilter_MedianInit(DSP_MEDIAN_T *f, unsigned char len)
+{
+    unsigned int i;
+
+    if ((len < 3U) || (len > DSP_FILTER_MEDIAN_MAX) || ((len & 1U) == 0U))
+    {
+        return -1;
+    }
+
+    for (i = 0U; i < DSP_FILTER_MEDIAN_MAX; i++)
+    {
+        f->hist[i]   = 0;
+        f->sorted[i] = 0;
+    }
+
+    f->len = len;
+    f->pos = 0U;
+
+    return 0;
+}
+
+void DspFilter_Median(DSP_MEDIAN_T *f, const int16_t *in, int16_t *out, unsigned int n)
+{
+    int16_t *sorted;
+    unsigned int len;
+    unsigned int pos;
+    unsigned int i;
+    int16_t old;
+    int16_t x;
+
+    sorted = f->sorted;
+    len    = f->len;
+    pos    = f->pos;
+
+    while (n--)
+    {
+        x = *in++;
+
+        old = f->hist[pos];
+        f->hist[pos] = x;
+        pos = (pos + 1U == len) ? 0U : pos + 1U;
+
+        /* oldest sample slot in sorted window take new value , then move it into order */
+        for (i = 0U; sorted[i] != old; i++)
+        {
+        }
+
+        while ((i > 0U) && (sorted[i - 1U] > x))
+        {
+            sorted[i] = sorted[i - 1U];
+            i--;
+        }
+
+        while ((i < (len - 1U)) && (sorted[i + 1U] < x))
+        {
+            sorted[i] = sorted[i + 1U];
+            i++;
+        }
+
+        sorted[i] = x;
+
+        *out++ = sorted[len >> 1];
+    }
+
+    f->pos = (uint8_t)pos;
+}
+
+#if defined (ENABLE_FILTER_BENCH) && !defined (DSP_FILTER_HOST)
+/* 2nd order Butterworth low pass , fc = fs / 10 */
+static const int16_t s_DspFilterBenchCoef[5] =
+{
+    DSP_Q14(0.0674553), DSP_Q14(0.1349105), DSP_Q14(0.0674553), DSP_Q14(-1.1429805), DSP_Q14(0.4128016)
+};
+
+static int16_t s_DspFilterBenchIn[DSP_FILTER_BENCH_LEN];
+static int16_t s_DspFilterBenchOut[DSP_FILTER_BENCH_LEN];
+
+static DSP_MA_T     s_DspFilterBenchMa;
+static DSP_CIC_T    s_DspFilterBenchCic;
+static DSP_BIQUAD_T s_DspFilterBenchBiquad;
+static DSP_MEDIAN_T s_DspFilterBenchMedian;
+
+/* op : 0 ma 16 , 1 cic 3 x 8 , 2 biquad 1 stage , 3 median 5 , 4 median 9 */
+static unsigned long DspFilter_BenchCycles(unsigned char op)
+{
+    uint32_t primask;
+    unsigned long start;
+    unsigned long cyc;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    start = get_systick_cycle();
+
+    switch (op)
+    {
+        case 0U: DspFilter_Ma(&s_DspFilterBenchMa, s_DspFilterBenchIn, s_DspFilterBenchOut, DSP_FILTER_BENCH_LEN); break;
+        case 1U: (void)DspFilter_Cic(&s_DspFilterBenchCic, s_DspFilterBenchIn, s_DspFilterBenchOut, DSP_FILTER_BENCH_LEN); break;
+        case 2U: DspFilter_Biquad(&s_DspFilterBenchBiquad, s_DspFilterBenchIn, s_DspFilterBenchOut, DSP_FILTER_BENCH_LEN); break;
+        default: DspFilter_Median(&s_DspFilterBenchMedian, s_DspFilterBenchIn, s_DspFilterBenchOut, DSP_FILTER_BENCH_LEN); break;
+    }
+
+    cyc = get_systick_cycle() - start;
+
+    __set_PRIMASK(primask);
+
+    return cyc;
+}
+
+void DspFilter_Benchmark(void)
+{
+    static const char * const name[5] = {"ma 16", "cic 3x8", "biquad", "median 5", "median 9"};
+    unsigned long cyc;
+    unsigned int i;
+    unsigned char op;
+
+    /* ramp with alternating spike , every kernel take its normal path */
+    for (i = 0U; i < DSP_FILTER_BENCH_LEN; i++)
+    {
+        s_DspFilterBenchIn[i] = (int16_t)((int)(i * 251U) - 16000 + ((i & 1U) ? 3000 : -3000));
+    }
+
+    (void)DspFilter_MaInit(&s_DspFilterBenchMa, 4U);
+    (void)DspFilter_CicInit(&s_DspFilterBenchCic, 3U, 3U);
+    (void)DspFilter_BiquadInit(&s_DspFilterBenchBiquad, s_DspFilterBenchCoef, 1U);
+
+    for (op = 0U; op < 5U; op++)
+    {
+        if (op >= 3U)
+        {
+            (void)DspFilter_MedianInit(&s_DspFilterBenchMedian, (op == 3U) ? 5U : 9U);
+        }
+
+        /* first run warm up state , second one measured */
+        (void)DspFilter_BenchCycles(op);
+        cyc = DspFilter_BenchCycles(op);
+
+        dbg_printf("%-8s : %3lu.%lu cycle / sample\r\n", name[op],
+                   cyc / DSP_FILTER_BENCH_LEN, ((cyc % DSP_FILTER_BENCH_LEN) * 10UL) / DSP_FILTER_BENCH_LEN);
+    }
+}
+#endif
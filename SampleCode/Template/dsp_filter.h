@@ -0,0 +1,106 @@
+#ifndef __DSP_FILTER_H__
+#define __DSP_FILTER_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdint.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * fixed point streaming filter for ADC block , Cortex-M0 (no FPU , 32 x 32 -> 32 MUL only)
+ *
+ * data is Q15 (int16_t) , accumulator / state Q31 (int32_t) , no 64 bit product
+ * block call : state carried across call , any block length , in / out may be the same buffer
+ *              except DspFilter_Cic (out shorter than in , may also be same buffer)
+ *
+ * ADC 12 bit sample to Q15 : DSP_FILTER_ADC_TO_Q15()
+ * plain C , also build on host (Tools/filter_bench.c , DSP_FILTER_HOST)
+ */
+#define DSP_FILTER_MA_MAX_SHIFT                 (5U)      /* moving average length up to 32 */
+#define DSP_FILTER_CIC_MAX_ORDER                (3U)
+#define DSP_FILTER_BIQUAD_MAX_STAGE             (4U)
+#define DSP_FILTER_MEDIAN_MAX                   (9U)      /* odd window length */
+
+#define DSP_FILTER_BENCH_LEN                    (128U)    /* sample per benchmark block */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* moving average , length 2^shift , running sum */
+typedef struct _dsp_ma_t
+{
+    int16_t          hist[1U << DSP_FILTER_MA_MAX_SHIFT];
+    int32_t          sum;
+    uint16_t         pos;
+    uint8_t          shift;
+    uint8_t          reserved;
+
+} DSP_MA_T;
+
+/* CIC decimator , order N , decimation R = 2^rshift , differential delay 1 , gain R^N removed by shift */
+typedef struct _dsp_cic_t
+{
+    uint32_t         integ[DSP_FILTER_CIC_MAX_ORDER];   /* modulo 2^32 , overflow is harmless */
+    uint32_t         comb[DSP_FILTER_CIC_MAX_ORDER];
+    uint16_t         phase;
+    uint8_t          order;
+    uint8_t          rshift;
+
+} DSP_CIC_T;
+
+/*
+ * biquad cascade , direct form I
+ * coef per stage {b0, b1, b2, a1, a2} in Q14 , y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2
+ * 32 bit accumulator : sum of stage term must stay inside +/- 4.0 (Q29) , output saturate
+ */
+typedef struct _dsp_biquad_t
+{
+    const int16_t   *coef;
+    int16_t          state[DSP_FILTER_BIQUAD_MAX_STAGE][4];     /* x1 x2 y1 y2 */
+    uint8_t          stages;
+    uint8_t          reserved[3];
+
+} DSP_BIQUAD_T;
+
+/* median of last len sample , sorted window updated in place , O(len) per sample */
+typedef struct _dsp_median_t
+{
+    int16_t          hist[DSP_FILTER_MEDIAN_MAX];
+    int16_t          sorted[DSP_FILTER_MEDIAN_MAX];
+    uint8_t          len;
+    uint8_t          pos;
+    uint8_t          reserved[2];
+
+} DSP_MEDIAN_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/* compile time coefficient */
+#define DSP_Q14(x)                              ((int16_t)(((x) * 16384.0) + (((x) < 0.0) ? -0.5 : 0.5)))
+
+/* 12 bit unsigned ADC to signed Q15 around mid scale */
+#define DSP_FILTER_ADC_TO_Q15(v)                ((int16_t)(((int32_t)(v) - 2048L) << 4))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* return 0 , -1 if parameter out of range */
+int  DspFilter_MaInit(DSP_MA_T *f, unsigned char shift);
+void DspFilter_Ma(DSP_MA_T *f, const int16_t *in, int16_t *out, unsigned int n);
+
+/* order * rshift <= 16 */
+int  DspFilter_CicInit(DSP_CIC_T *f, unsigned char order, unsigned char rshift);
+/* return output count , 0 .. (phase + n) / R */
+unsigned int DspFilter_Cic(DSP_CIC_T *f, const int16_t *in, int16_t *out, unsigned int n);
+
+/* coef : stages x 5 , must stay valid */
+int  DspFilter_BiquadInit(DSP_BIQUAD_T *f, const int16_t *coef, unsigned char stages);
+void DspFilter_Biquad(DSP_BIQUAD_T *f, const int16_t *in, int16_t *out, unsigned int n);
+
+/* len odd , 3 .. DSP_FILTER_MEDIAN_MAX */
+int  DspFilter_MedianInit(DSP_MEDIAN_T *f, unsigned char len);
+void DspFilter_Median(DSP_MEDIAN_T *f, const int16_t *in, int16_t *out, unsigned int n);
+
+/* ENABLE_FILTER_BENCH , SysTick cycle per sample of each kernel , print to debug UART */
+void DspFilter_Benchmark(void);
+
+#endif //__DSP_FILTER_H__
@@ -0,0 +1,375 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "hdiv_rt.h"
+
+#if defined (ENABLE_HDIV_RT)
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define HDIV_RT_BENCH_LEN                       (64U)
+
+#if defined (__ARMCC_VERSION)
+/* armlink patch : $Sub$$x replace every call of x , $Super$$x is the library x */
+#define HDIV_RT_UIDIV                           $Sub$$__aeabi_uidiv
+#define HDIV_RT_IDIV                            $Sub$$__aeabi_idiv
+#define HDIV_RT_UIDIVMOD                        $Sub$$__aeabi_uidivmod
+#define HDIV_RT_IDIVMOD                         $Sub$$__aeabi_idivmod
+
+#define HDIV_RT_LIB_UIDIV                       $Super$$__aeabi_uidiv
+#define HDIV_RT_LIB_IDIV                        $Super$$__aeabi_idiv
+#define HDIV_RT_LIB_UIDIVMOD                    $Super$$__aeabi_uidivmod
+#define HDIV_RT_LIB_IDIVMOD                     $Super$$__aeabi_idivmod
+
+/* divmod : quotient r0 , remainder r1 , same register pair as 64 bit return */
+extern unsigned int HDIV_RT_LIB_UIDIV(unsigned int n, unsigned int d);
+extern int HDIV_RT_LIB_IDIV(int n, int d);
+extern unsigned long long HDIV_RT_LIB_UIDIVMOD(unsigned int n, unsigned int d);
+extern unsigned long long HDIV_RT_LIB_IDIVMOD(int n, int d);
+#else
+#define HDIV_RT_UIDIV                           __aeabi_uidiv
+#define HDIV_RT_IDIV                            __aeabi_idiv
+#define HDIV_RT_UIDIVMOD                        __aeabi_uidivmod
+#define HDIV_RT_IDIVMOD                         __aeabi_idivmod
+
+#define HDIV_RT_LIB_UIDIV(n, d)                 ((unsigned int)HdivRt_SoftUdivmod((n), (d)))
+#define HDIV_RT_LIB_IDIV(n, d)                  ((int)HdivRt_SoftIdivmod((n), (d)))
+#define HDIV_RT_LIB_UIDIVMOD(n, d)              HdivRt_SoftUdivmod((n), (d))
+#define HDIV_RT_LIB_IDIVMOD(n, d)               HdivRt_SoftIdivmod((n), (d))
+#endif
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile unsigned char g_HdivRtEnable = 0U;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define HDIV_RT_ENTER_CRITICAL(m)               do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define HDIV_RT_EXIT_CRITICAL(m)                __set_PRIMASK(m)
+
+/* quotient low word (r0) , remainder high word (r1) */
+#define HDIV_RT_PAIR(q, r)                      (((unsigned long long)(uint32_t)(r) << 32) | (uint32_t)(q))
+
+/* divisor HDIV can take */
+#define HDIV_RT_UD_OK(d)                        (((d) - 1U) < 0x7FFFU)
+#define HDIV_RT_ID_OK(d)                        ((((uint32_t)(d) + 0x8000UL) <= 0xFFFFUL) && ((d) != 0))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+#if !defined (__ARMCC_VERSION)
+/* no "/" in here , it would call back into __aeabi_uidiv */
+static unsigned long long HdivRt_SoftUdivmod(unsigned int n, unsigned int d)
+{
+    unsigned int q = 0U;
+    unsigned int bit = 1U;
+
+    if (d == 0U)
+    {
+        return HDIV_RT_PAIR(0U, n);
+    }
+
+    while ((d < n) && ((d & 0x80000000U) == 0U))
+    {
+        d <<= 1;
+        bit <<= 1;
+    }
+
+    while (bit != 0U)
+    {
+        if (n >= d)
+        {
+            n -= d;
+            q |= bit;
+        }
+        d >>= 1;
+        bit >>= 1;
+    }
+
+    return HDIV_RT_PAIR(q, n);
+}
+
+/* quotient round toward zero , remainder sign of dividend */
+static unsigned long long HdivRt_SoftIdivmod(int n, int d)
+{
+    unsigned long long qr;
+    unsigned int q;
+    unsigned int r;
+
+    qr = HdivRt_SoftUdivmod((n < 0) ? (0U - (unsigned int)n) : (unsigned int)n,
+                            (d < 0) ? (0U - (unsigned int)d) : (unsigned int)d);
+    q  = (unsigned int)qr;
+    r  = (unsigned int)(qr >> 32);
+
+    if ((n < 0) != (d < 0))
+    {
+        q = 0U - q;
+    }
+
+    if (n < 0)
+    {
+        r = 0U - r;
+    }
+
+    return HDIV_RT_PAIR(q, r);
+}
+#endif
+
+/* HDIV signed 32 / signed 16 , whole sequence in critical section : ISR may use HDIV too */
+static int HdivRt_Hw(int n, int d, int *rem)
+{
+    uint32_t primask;
+    int q;
+
+    HDIV_RT_ENTER_CRITICAL(primask);
+
+    HDIV->DIVIDEND = (uint32_t)n;
+    HDIV->DIVISOR  = (uint32_t)d;
+    __NOP();
+    q    = (int)HDIV->QUOTIENT;
+    *rem = (int)HDIV->REM;
+
+    HDIV_RT_EXIT_CRITICAL(primask);
+
+    return q;
+}
+
+/* d 1 .. 32767 */
+static unsigned int HdivRt_HwU(unsigned int n, unsigned int d, unsigned int *rem)
+{
+    unsigned int q;
+    int r;
+
+    if ((n & 0x80000000U) == 0U)
+    {
+        q    = (unsigned int)HdivRt_Hw((int)n, (int)d, &r);
+        *rem = (unsigned int)r;
+        return q;
+    }
+
+    /* 2 * ((n / 2) / d) is the quotient or one below */
+    q    = (unsigned int)HdivRt_Hw((int)(n >> 1), (int)d, &r) << 1;
+    *rem = n - (q * d);
+
+    if (*rem >= d)
+    {
+        q++;
+        *rem -= d;
+    }
+
+    return q;
+}
+
+unsigned int HDIV_RT_UIDIV(unsigned int n, unsigned int d)
+{
+    unsigned int r;
+
+    if (g_HdivRtEnable && HDIV_RT_UD_OK(d))
+    {
+        return HdivRt_HwU(n, d, &r);
+    }
+
+    return HDIV_RT_LIB_UIDIV(n, d);
+}
+
+int HDIV_RT_IDIV(int n, int d)
+{
+    int r;
+
+    if (g_HdivRtEnable && HDIV_RT_ID_OK(d))
+    {
+        return HdivRt_Hw(n, d, &r);
+    }
+
+    return HDIV_RT_LIB_IDIV(n, d);
+}
+
+unsigned long long HDIV_RT_UIDIVMOD(unsigned int n, unsigned int d)
+{
+    unsigned int q;
+    unsigned int r;
+
+    if (g_HdivRtEnable && HDIV_RT_UD_OK(d))
+    {
+        q = HdivRt_HwU(n, d, &r);
+        return HDIV_RT_PAIR(q, r);
+    }
+
+    return HDIV_RT_LIB_UIDIVMOD(n, d);
+}
+
+unsigned long long HDIV_RT_IDIVMOD(int n, int d)
+{
+    int q;
+    int r;
+
+    if (g_HdivRtEnable && HDIV_RT_ID_OK(d))
+    {
+        q = HdivRt_Hw(n, d, &r);
+        return HDIV_RT_PAIR(q, r);
+    }
+
+    return HDIV_RT_LIB_IDIVMOD(n, d);
+}
+
+void HdivRt_Enable(unsigned char on)
+{
+    g_HdivRtEnable = on ? 1U : 0U;
+}
+
+unsigned char HdivRt_IsEnabled(void)
+{
+    return g_HdivRtEnable;
+}
+
+/* benchmark */
+static volatile unsigned int s_HdivRtBenchN[HDIV_RT_BENCH_LEN];     /* below 2^31 */
+static volatile unsigned int s_HdivRtBenchH[HDIV_RT_BENCH_LEN];     /* 2^31 and above , unsigned correction path */
+static volatile unsigned int s_HdivRtBenchD[HDIV_RT_BENCH_LEN];
+static volatile unsigned int s_HdivRtBenchSink;
+
+/*
+ * op : 0 udiv , 1 udiv hi , 2 idiv , 3 umod , 4 umod hi , 5 TIMER_Open , 6 PWM_ConfigOutputChannel , 7 snprintf
+ * PWM1 is not used by the template , TIMER3 only while counter is off (pwm_seq.c step clock) , register write only
+ */
+static unsigned long HdivRt_BenchCycles(unsigned char op)
+{
+    char buf[24];
+    uint32_t primask;
+    unsigned long start;
+    unsigned long cyc;
+    unsigned int acc = 0U;
+    unsigned int i;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    start = get_systick_cycle();
+
+    switch (op)
+    {
+        case 0U:
+            for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+            {
+                acc += s_HdivRtBenchN[i] / s_HdivRtBenchD[i];
+            }
+            break;
+
+        case 1U:
+            for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+            {
+                acc += s_HdivRtBenchH[i] / s_HdivRtBenchD[i];
+            }
+            break;
+
+        case 2U:
+            for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+            {
+                acc += (unsigned int)((int)s_HdivRtBenchN[i] / -(int)s_HdivRtBenchD[i]);
+            }
+            break;
+
+        case 3U:
+            for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+            {
+                acc += s_HdivRtBenchN[i] % s_HdivRtBenchD[i];
+            }
+            break;
+
+        case 4U:
+            for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+            {
+                acc += s_HdivRtBenchH[i] % s_HdivRtBenchD[i];
+            }
+            break;
+
+        case 5U:
+            acc = TIMER_Open(TIMER3, TIMER_PERIODIC_MODE, 1000UL);
+            break;
+
+        case 6U:
+            acc = PWM_ConfigOutputChannel(PWM1, 0UL, 100UL, 30UL);
+            break;
+
+        default:
+            acc = (unsigned int)snprintf(buf, sizeof(buf), "%lu %lu", 4000000000UL, 1234567UL);
+            break;
+    }
+
+    cyc = get_systick_cycle() - start;
+
+    __set_PRIMASK(primask);
+
+    s_HdivRtBenchSink = acc;
+
+    return cyc;
+}
+
+void HdivRt_Benchmark(void)
+{
+    static const char * const name[8] = {"udiv x64", "udiv hi x64", "idiv x64", "umod x64", "umod hi x64",
+                                         "TIMER_Open", "PWM config", "snprintf"};
+    unsigned long cyc[2];
+    unsigned long seed = 1UL;
+    unsigned long pwm_clk;
+    unsigned int i;
+    unsigned char tmr_busy;
+    unsigned char on;
+    unsigned char op;
+    unsigned char k;
+
+    /*
+     * divisor 3 .. 30002 : all inside HDIV range
+     * dividend below 2^31 : one HDIV divide , hi (2^31 and above) : (n / 2) / d and correction
+     */
+    for (i = 0U; i < HDIV_RT_BENCH_LEN; i++)
+    {
+        seed = (seed * 1103515245UL) + 12345UL;
+        s_HdivRtBenchN[i] = (unsigned int)(seed >> 1);
+        s_HdivRtBenchH[i] = (unsigned int)(seed >> 1) | 0x80000000U;
+        s_HdivRtBenchD[i] = (unsigned int)((seed >> 17) % 30000UL) + 3U;
+    }
+
+    pwm_clk = (CLK->CLKSEL2 & CLK_CLKSEL2_PWM1SEL_Msk) ? CLK_GetPCLK1Freq() : CLK_GetPLLClockFreq();
+
+    on = HdivRt_IsEnabled();
+    tmr_busy = (TIMER3->CTL & TIMER_CTL_CNTEN_Msk) ? 1U : 0U;
+
+    for (op = 0U; op < 8U; op++)
+    {
+        if ((op == 5U) && tmr_busy)
+        {
+            dbg_printf("%-11s : skip , TIMER3 in use\r\n", name[op]);
+            continue;
+        }
+
+        /* driver math divide by source clock : skip if it is 0 */
+        if (((op == 5U) && (TIMER_GetModuleClock(TIMER3) == 0UL)) ||
+            ((op == 6U) && (pwm_clk == 0UL)))
+        {
+            dbg_printf("%-11s : skip , no clock source\r\n", name[op]);
+            continue;
+        }
+
+        for (k = 0U; k < 2U; k++)
+        {
+            HdivRt_Enable(k);
+
+            /* first run warm up , second one measured */
+            (void)HdivRt_BenchCycles(op);
+            cyc[k] = HdivRt_BenchCycles(op);
+        }
+
+        HdivRt_Enable(on);
+
+        dbg_printf("%-11s : lib %5lu , hdiv %5lu cycle\r\n", name[op], cyc[0], cyc[1]);
+    }
+
+    if (tmr_busy == 0U)
+    {
+        TIMER_Close(TIMER3);
+    }
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef __HDIV_RT_H__
+#define __HDIV_RT_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * ENABLE_HDIV_RT : runtime library integer division through HDIV
+ *
+ * __aeabi_uidiv / __aeabi_idiv / __aeabi_uidivmod / __aeabi_idivmod (every C "/" and "%" of
+ * 32 bit int , driver and libc included) are patched :
+ *   armclang : armlink $Sub$$ / $Super$$ , library routine kept for the cases HDIV can not do
+ *   other    : replace the library routine , shift-subtract for the cases HDIV can not do
+ *
+ * HDIV is signed 32 / signed 16 :
+ *   signed   : divisor -32768 .. 32767
+ *   unsigned : divisor 1 .. 32767 , dividend above 0x7FFFFFFF by (n / 2) / d and one correction
+ *   divisor 0 , larger divisor , HdivRt disabled : library routine , behavior unchanged
+ *
+ * HDIV is one shared register set (also lite_printf.c) : write / read inside PRIMASK critical
+ * section , safe in ISR , about 12 cycle of IRQ latency at most
+ */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * on 1 : use HDIV , call after CLK_EnableModuleClock(HDIV_MODULE)
+ * division before that (startup , SystemCoreClockUpdate) run the library routine
+ */
+void HdivRt_Enable(unsigned char on);
+unsigned char HdivRt_IsEnabled(void);
+
+/* cycle of division loop (dividend below / above 2^31) and driver clock math , library vs HDIV , print to debug UART */
+void HdivRt_Benchmark(void);
+
+#endif //__HDIV_RT_H__
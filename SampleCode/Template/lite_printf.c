@@ -0,0 +1,445 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "lite_printf.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define LITE_PRINTF_FLAG_LEFT                   (0x01U)
+#define LITE_PRINTF_FLAG_ZERO                   (0x02U)
+
+#define LITE_PRINTF_BENCH_LOOP                  (16UL)
+
+extern void SendChar_ToUART(int ch);
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static const char s_LitePrintfHexUpper[] = "0123456789ABCDEF";
+static const char s_LitePrintfHexLower[] = "0123456789abcdef";
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define LITE_PRINTF_ENTER_CRITICAL(m)           do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define LITE_PRINTF_EXIT_CRITICAL(m)            __set_PRIMASK(m)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * v / 10 by HDIV , remainder in *rem
+ * HDIV dividend is signed 32-bit : value above 0x7FFFFFFF use (v / 2) / 5
+ * HDIV is one shared register set , access inside critical section for ISR use
+ */
+static unsigned long LitePrintf_DivMod10(unsigned long v, unsigned char *rem)
+{
+    uint32_t primask;
+    unsigned long q;
+
+    LITE_PRINTF_ENTER_CRITICAL(primask);
+
+    if (v & 0x80000000UL)
+    {
+        HDIV->DIVIDEND = (uint32_t)(v >> 1);
+        HDIV->DIVISOR  = 5UL;
+    }
+    else
+    {
+        HDIV->DIVIDEND = (uint32_t)v;
+        HDIV->DIVISOR  = 10UL;
+    }
+    __NOP();
+    q = HDIV->QUOTIENT;
+
+    LITE_PRINTF_EXIT_CRITICAL(primask);
+
+    *rem = (unsigned char)(v - (q * 10UL));
+
+    return q;
+}
+
+/* digit in reverse order into tmp , return count */
+static unsigned int LitePrintf_Utoa(char *tmp, unsigned long v, unsigned char base, const char *digit)
+{
+    unsigned int n = 0U;
+    unsigned char rem;
+
+    do
+    {
+        if (base == 16U)
+        {
+            tmp[n++] = digit[v & 0x0FUL];
+            v >>= 4;
+        }
+        else
+        {
+            v = LitePrintf_DivMod10(v, &rem);
+            tmp[n++] = digit[rem];
+        }
+    } while (v != 0UL);
+
+    return n;
+}
+
+int LitePrintf_Format(char *buf, unsigned int size, const char *fmt, va_list ap)
+{
+    char tmp[12];
+    const char *s;
+    unsigned long v;
+    unsigned int pos;
+    unsigned int len;
+    unsigned int width;
+    unsigned int pad;
+    unsigned char flags;
+    unsigned char lng;
+    unsigned char base;
+    unsigned char rev;
+    char sign;
+    char c;
+
+    if ((buf == (char *)0) || (size == 0U))
+    {
+        return 0;
+    }
+
+    pos = 0U;
+
+    /* argument always evaluated : caller loop advance by side effect even when buf is full */
+    #define LITE_PRINTF_PUT(ch)     do { char ch_ = (char)(ch); if (pos < (size - 1U)) { buf[pos++] = ch_; } } while (0)
+
+    while ((c = *fmt++) != '\0')
+    {
+        if (c != '%')
+        {
+            LITE_PRINTF_PUT(c);
+            continue;
+        }
+
+        flags = 0U;
+        width = 0U;
+        lng   = 0U;
+        sign  = 0;
+
+        for (;;)
+        {
+            if (*fmt == '-')
+            {
+                flags |= LITE_PRINTF_FLAG_LEFT;
+            }
+            else if (*fmt == '0')
+            {
+                flags |= LITE_PRINTF_FLAG_ZERO;
+            }
+            else
+            {
+                break;
+            }
+            fmt++;
+        }
+
+        while ((*fmt >= '0') && (*fmt <= '9'))
+        {
+            width = (width * 10U) + (unsigned int)(*fmt++ - '0');
+        }
+
+        if (*fmt == 'l')
+        {
+            lng = 1U;
+            fmt++;
+        }
+        else if (*fmt == 'z')
+        {
+            lng = 2U;
+            fmt++;
+        }
+
+        c = *fmt++;
+        if (c == '\0')
+        {
+            break;
+        }
+
+        s    = tmp;
+        base = 10U;
+        rev  = 1U;      /* number : digit in reverse order */
+
+        switch (c)
+        {
+            case 'd':
+            case 'i':
+            {
+                long sv;
+
+                sv = (lng == 1U) ? va_arg(ap, long) : (long)va_arg(ap, int);
+                if (sv < 0L)
+                {
+                    sign = '-';
+                    v = (unsigned long)0UL - (unsigned long)sv;
+                }
+                else
+                {
+                    v = (unsigned long)sv;
+                }
+                len = LitePrintf_Utoa(tmp, v, 10U, s_LitePrintfHexUpper);
+                break;
+            }
+
+            case 'u':
+            case 'x':
+            case 'X':
+            case 'p':
+                if (c == 'p')
+                {
+                    v = (unsigned long)(uintptr_t)va_arg(ap, void *);
+                    flags |= LITE_PRINTF_FLAG_ZERO;
+                    width = 8U;
+                }
+                else if (lng == 1U)
+                {
+                    v = va_arg(ap, unsigned long);
+                }
+                else if (lng == 2U)
+                {
+                    v = (unsigned long)va_arg(ap, size_t);
+                }
+                else
+                {
+                    v = (unsigned long)va_arg(ap, unsigned int);
+                }
+
+                if (c != 'u')
+                {
+                    base = 16U;
+                }
+                len = LitePrintf_Utoa(tmp, v, base, (c == 'x') ? s_LitePrintfHexLower : s_LitePrintfHexUpper);
+                break;
+
+            case 'c':
+                tmp[0] = (char)va_arg(ap, int);
+                len = 1U;
+                rev = 0U;
+                break;
+
+            case 's':
+                s = va_arg(ap, const char *);
+                if (s == (const char *)0)
+                {
+                    s = "(null)";
+                }
+                len = (unsigned int)strlen(s);
+                rev = 0U;
+                break;
+
+            default:        /* %% and unknown : print as is */
+                tmp[0] = c;
+                len = 1U;
+                rev = 0U;
+                break;
+        }
+
+        pad = (width > (len + ((sign != 0) ? 1U : 0U))) ? (width - len - ((sign != 0) ? 1U : 0U)) : 0U;
+
+        if ((flags & LITE_PRINTF_FLAG_LEFT) == 0U)
+        {
+            if ((flags & LITE_PRINTF_FLAG_ZERO) && (rev != 0U))
+            {
+                if (sign != 0)
+                {
+                    LITE_PRINTF_PUT(sign);
+                    sign = 0;
+                }
+                for (; pad > 0U; pad--)
+                {
+                    LITE_PRINTF_PUT('0');
+                }
+            }
+            else
+            {
+                for (; pad > 0U; pad--)
+                {
+                    LITE_PRINTF_PUT(' ');
+                }
+            }
+        }
+
+        if (sign != 0)
+        {
+            LITE_PRINTF_PUT(sign);
+        }
+
+        if (rev != 0U)
+        {
+            while (len > 0U)
+            {
+                LITE_PRINTF_PUT(tmp[--len]);
+            }
+        }
+        else
+        {
+            while (len > 0U)
+            {
+                LITE_PRINTF_PUT(*s++);
+                len--;
+            }
+        }
+
+        for (; pad > 0U; pad--)
+        {
+            LITE_PRINTF_PUT(' ');
+        }
+    }
+
+    #undef LITE_PRINTF_PUT
+
+    buf[pos] = '\0';
+
+    return (int)pos;
+}
+
+int LitePrintf_Snprintf(char *buf, unsigned int size, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = LitePrintf_Format(buf, size, fmt, ap);
+    va_end(ap);
+
+    return n;
+}
+
+#if defined (DEBUG_TX_IRQ)
+/* '\n' -> "\r\n" in place as SendChar_ToUART does , tail cut if no room , return new length */
+static unsigned int LitePrintf_AddCr(char *buf, unsigned int len, unsigned int size)
+{
+    unsigned int nl = 0U;
+    unsigned int src;
+    unsigned int dst;
+
+    for (src = 0U; src < len; src++)
+    {
+        nl += (buf[src] == '\n') ? 1U : 0U;
+    }
+
+    while ((len + nl) > (size - 1U))
+    {
+        len--;
+        nl -= (buf[len] == '\n') ? 1U : 0U;
+    }
+
+    /* back to front , dst never behind src */
+    src = len;
+    dst = len + nl;
+    buf[dst] = '\0';
+
+    while (src != dst)
+    {
+        buf[--dst] = buf[--src];
+        if (buf[src] == '\n')
+        {
+            buf[--dst] = '\r';
+        }
+    }
+
+    return len + nl;
+}
+#endif
+
+int LitePrintf_Printf(const char *fmt, ...)
+{
+    char buf[LITE_PRINTF_BUF_SIZE];
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = LitePrintf_Format(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+
+    #if defined (DEBUG_TX_IRQ)
+    /* raw ring write , no translation on the way */
+    n = (int)LitePrintf_AddCr(buf, (unsigned int)n, sizeof(buf));
+
+    if (DebugTx_WriteRaw((const uint8_t *)buf, (uint32_t)n) != 0)
+    {
+        return -1;
+    }
+    #else
+    {
+        int i;
+
+        for (i = 0; i < n; i++)
+        {
+            SendChar_ToUART(buf[i]);
+        }
+    }
+    #endif
+
+    return n;
+}
+
+/*
+ * core cycle of one call (get_systick_cycle)
+ * run with interrupt disabled : valid below two SysTick period (1 ms , SysTick_enable)
+ */
+static unsigned long LitePrintf_BenchCycles(unsigned char use_libc, char *buf, unsigned int size, const char *fmt, ...)
+{
+    va_list ap;
+    uint32_t primask;
+    unsigned long start;
+    unsigned long cyc;
+
+    LITE_PRINTF_ENTER_CRITICAL(primask);
+
+    va_start(ap, fmt);
+
+    start = get_systick_cycle();
+
+    if (use_libc)
+    {
+        (void)vsnprintf(buf, size, fmt, ap);
+    }
+    else
+    {
+        (void)LitePrintf_Format(buf, size, fmt, ap);
+    }
+
+    cyc = get_systick_cycle() - start;
+
+    va_end(ap);
+
+    LITE_PRINTF_EXIT_CRITICAL(primask);
+
+    return cyc;
+}
+
+void LitePrintf_Benchmark(void)
+{
+    char buf[LITE_PRINTF_BUF_SIZE];
+    unsigned long libc[4] = {0UL, 0UL, 0UL, 0UL};
+    unsigned long lite[4] = {0UL, 0UL, 0UL, 0UL};
+    unsigned long i;
+    unsigned char m;
+
+    for (i = 0UL; i < LITE_PRINTF_BENCH_LOOP; i++)
+    {
+        for (m = 0U; m < 2U; m++)
+        {
+            unsigned long *r = (m == 0U) ? libc : lite;
+
+            r[0] += LitePrintf_BenchCycles(m == 0U, buf, sizeof(buf), "%s:%4lu (1 sec)\r\n", __FUNCTION__, 0x12345678UL + i);
+            r[1] += LitePrintf_BenchCycles(m == 0U, buf, sizeof(buf), "%d,%u,%d\r\n", -123456, 4000000000U, (int)i);
+            r[2] += LitePrintf_BenchCycles(m == 0U, buf, sizeof(buf), "0x%08lX %04X %02X\r\n", 0xDEADBEEFUL + i, 0xBEEFU, 0x5AU);
+            r[3] += LitePrintf_BenchCycles(m == 0U, buf, sizeof(buf), "CLK_GetCPUFreq : %8d\r\n", (int)SystemCoreClock);
+        }
+    }
+
+    for (m = 0U; m < 4U; m++)
+    {
+        LitePrintf_Printf("fmt%u : libc %6lu cycle , lite %6lu cycle\r\n",
+                          (unsigned int)m,
+                          libc[m] / LITE_PRINTF_BENCH_LOOP,
+                          lite[m] / LITE_PRINTF_BENCH_LOOP);
+    }
+}
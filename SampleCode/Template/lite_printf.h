@@ -0,0 +1,39 @@
+#ifndef __LITE_PRINTF_H__
+#define __LITE_PRINTF_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdarg.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * supported : %d %i %u %x %X %c %s %p %%
+ * flag '-' '0' , width , length 'l' 'z'
+ * no float , no precision
+ */
+#define LITE_PRINTF_BUF_SIZE                    (128U)    /* stack buffer of LitePrintf_Printf */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * reentrant , no heap , HDIV for decimal conversion (HDIV_MODULE clock required)
+ * always terminate buf , return number of char stored (without '\0')
+ */
+int  LitePrintf_Format(char *buf, unsigned int size, const char *fmt, va_list ap);
+int  LitePrintf_Snprintf(char *buf, unsigned int size, const char *fmt, ...);
+
+/*
+ * format on stack then send to debug UART , '\n' sent as "\r\n" same as printf
+ * with DEBUG_TX_IRQ : one atomic ring write , ISR safe , return -1 if ring full (dropped)
+ * without           : polling output
+ */
+int  LitePrintf_Printf(const char *fmt, ...);
+
+/* cycles per call , libc vsnprintf vs LitePrintf_Format , result print to debug UART */
+void LitePrintf_Benchmark(void);
+
+#endif //__LITE_PRINTF_H__
@@ -0,0 +1,295 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NuMicro.h"
+
+#include "log.h"
+#include "timer_service.h"
+#include "shell.h"
+
+#if defined (ENABLE_LITE_PRINTF)
+#include "lite_printf.h"
+#endif
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _log_t
+{
+    unsigned char  level[LOG_MOD_NUM];
+    unsigned char  token[LOG_MOD_NUM];
+    unsigned long  refill[LOG_MOD_NUM];     /* tick of last token refill */
+    unsigned long  suppress[LOG_MOD_NUM];   /* total dropped by rate limit */
+    unsigned long  pending[LOG_MOD_NUM];    /* dropped since last line sent */
+
+} LOG_T;
+
+extern void SendChar_ToUART(int ch);
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+#define LOG_MODULE_NAME(id, name)               name,
+
+static const char * const g_LogModuleName[LOG_MOD_NUM] =
+{
+    LOG_MODULE_LIST(LOG_MODULE_NAME)
+};
+
+static const char g_LogLevelChar[] = "-EWID";
+
+static volatile LOG_T g_Log;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define LOG_ENTER_CRITICAL(m)                   do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define LOG_EXIT_CRITICAL(m)                    __set_PRIMASK(m)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+void Log_SetLevel(unsigned char module, unsigned char level)
+{
+    if (module < LOG_MOD_NUM)
+    {
+        g_Log.level[module] = (level > LOG_LEVEL_DEBUG) ? LOG_LEVEL_DEBUG : level;
+    }
+}
+
+void Log_SetLevelAll(unsigned char level)
+{
+    unsigned char i;
+
+    for (i = 0U; i < LOG_MOD_NUM; i++)
+    {
+        Log_SetLevel(i, level);
+    }
+}
+
+unsigned char Log_GetLevel(unsigned char module)
+{
+    return (module < LOG_MOD_NUM) ? g_Log.level[module] : LOG_LEVEL_NONE;
+}
+
+unsigned long Log_GetSuppressCnt(unsigned char module)
+{
+    return (module < LOG_MOD_NUM) ? g_Log.suppress[module] : 0UL;
+}
+
+int Log_FindModule(const char *name)
+{
+    unsigned int i;
+
+    for (i = 0U; i < LOG_MOD_NUM; i++)
+    {
+        if (strcmp(name, g_LogModuleName[i]) == 0)
+        {
+            return (int)i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * token bucket , one token per LOG_RATE_INTERVAL_MS up to LOG_RATE_BURST
+ * return line dropped before this one , -1 if this line must be dropped
+ */
+static long Log_TakeToken(unsigned char module)
+{
+    volatile LOG_T *l;
+    unsigned long now;
+    unsigned long n;
+    unsigned long dropped;
+    uint32_t primask;
+
+    l   = &g_Log;
+    now = TimerService_GetTick();
+
+    LOG_ENTER_CRITICAL(primask);
+
+    n = (now - l->refill[module]) / LOG_RATE_INTERVAL_MS;
+    if (n != 0UL)
+    {
+        l->refill[module] += n * LOG_RATE_INTERVAL_MS;     /* keep remainder */
+        n += l->token[module];
+        l->token[module]   = (unsigned char)((n > LOG_RATE_BURST) ? LOG_RATE_BURST : n);
+    }
+
+    if (l->token[module] == 0U)
+    {
+        l->suppress[module]++;
+        l->pending[module]++;
+        LOG_EXIT_CRITICAL(primask);
+        return -1;
+    }
+
+    l->token[module]--;
+    dropped = l->pending[module];
+    l->pending[module] = 0UL;
+
+    LOG_EXIT_CRITICAL(primask);
+
+    return (long)dropped;
+}
+
+static int Log_Format(char *buf, unsigned int size, const char *fmt, va_list ap)
+{
+    int n;
+
+    #if defined (ENABLE_LITE_PRINTF)
+    n = LitePrintf_Format(buf, size, fmt, ap);
+    #else
+    n = vsnprintf(buf, size, fmt, ap);
+    #endif
+
+    if (n < 0)
+    {
+        n = 0;
+    }
+    else if ((unsigned int)n >= size)
+    {
+        n = (int)(size - 1U);   /* cut */
+    }
+
+    return n;
+}
+
+static int Log_Format_Va(char *buf, unsigned int size, const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+
+    va_start(ap, fmt);
+    n = Log_Format(buf, size, fmt, ap);
+    va_end(ap);
+
+    return n;
+}
+
+/* whole line or nothing */
+static int Log_Output(const char *buf, unsigned int len)
+{
+    #if defined (DEBUG_TX_IRQ)
+    return (DebugTx_WriteRaw((const uint8_t *)buf, (uint32_t)len) == 0) ? 0 : -1;
+    #else
+    unsigned int i;
+
+    for (i = 0U; i < len; i++)
+    {
+        SendChar_ToUART(buf[i]);
+    }
+
+    return 0;
+    #endif
+}
+
+int Log_Write(unsigned char module, unsigned char level, const char *fmt, ...)
+{
+    char buf[LOG_LINE_SIZE];
+    va_list ap;
+    long dropped;
+    int n;
+
+    if ((module >= LOG_MOD_NUM) || (level == LOG_LEVEL_NONE) || (level > g_Log.level[module]))
+    {
+        return -1;
+    }
+
+    dropped = Log_TakeToken(module);
+    if (dropped < 0)
+    {
+        return -1;
+    }
+
+    n = Log_Format_Va(buf, sizeof(buf), "[%6lu] %c %s: ",
+                      TimerService_GetTick(), g_LogLevelChar[level], g_LogModuleName[module]);
+
+    if (dropped > 0)
+    {
+        n += Log_Format_Va(&buf[n], sizeof(buf) - (unsigned int)n, "(%ld suppressed) ", dropped);
+    }
+
+    va_start(ap, fmt);
+    n += Log_Format(&buf[n], sizeof(buf) - (unsigned int)n, fmt, ap);
+    va_end(ap);
+
+    return Log_Output(buf, (unsigned int)n);
+}
+
+static int Log_CmdLog(int argc, char *argv[])
+{
+    unsigned int i;
+    unsigned long v;
+    char *end;
+    int mod;
+
+    if (argc == 1)
+    {
+        printf("compile max %d\r\n", LOG_LEVEL_MAX);
+        printf("module level suppress\r\n");
+        for (i = 0U; i < LOG_MOD_NUM; i++)
+        {
+            printf("%-6s %5u %8lu\r\n", g_LogModuleName[i], (unsigned int)g_Log.level[i], g_Log.suppress[i]);
+        }
+        return 0;
+    }
+
+    if (argc != 3)
+    {
+        printf("usage : log <module|all> <0-4>\r\n");
+        return -1;
+    }
+
+    v = strtoul(argv[2], &end, 0);
+    if ((*end != '\0') || (argv[2][0] == '\0') || (v > LOG_LEVEL_DEBUG))
+    {
+        printf("invalid level\r\n");
+        return -1;
+    }
+
+    if (strcmp(argv[1], "all") == 0)
+    {
+        Log_SetLevelAll((unsigned char)v);
+        return 0;
+    }
+
+    mod = Log_FindModule(argv[1]);
+    if (mod < 0)
+    {
+        printf("unknown module %s\r\n", argv[1]);
+        return -1;
+    }
+
+    Log_SetLevel((unsigned char)mod, (unsigned char)v);
+
+    return 0;
+}
+
+static const SHELL_CMD_T s_LogCmd =
+{
+    "log",  Log_CmdLog,  "log [<module|all> <0-4>] , 0 none 1 err 2 warn 3 info 4 debug"
+};
+
+int Log_Register(void)
+{
+    return (Shell_Register(&s_LogCmd) == 0) ? 1 : 0;
+}
+
+void Log_Init(void)
+{
+    volatile LOG_T *l;
+    unsigned long now;
+    unsigned char i;
+
+    l   = &g_Log;
+    now = TimerService_GetTick();
+
+    for (i = 0U; i < LOG_MOD_NUM; i++)
+    {
+        l->level[i]    = LOG_LEVEL_MAX;
+        l->token[i]    = LOG_RATE_BURST;
+        l->refill[i]   = now;
+        l->suppress[i] = 0UL;
+        l->pending[i]  = 0UL;
+    }
+}
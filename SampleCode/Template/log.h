@@ -0,0 +1,124 @@
+#ifndef __LOG_H__
+#define __LOG_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "log_module.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * per module leveled log
+ *
+ *   #define LOG_MODULE          LOG_MOD_UART
+ *   #define LOG_MODULE_LEVEL    LOG_LEVEL_WARN      (optional , default LOG_LEVEL_MAX)
+ *   #include "log.h"
+ *
+ *   LOG_W("overrun %lu\r\n", cnt);
+ *
+ * compile time : LOG_x() above min(LOG_LEVEL_MAX , LOG_MODULE_LEVEL) expand to nothing ,
+ *                format string and argument are not in flash
+ * run time     : Log_SetLevel() filter what is left , token bucket per module limit output rate
+ */
+#define LOG_LEVEL_NONE                          (0)
+#define LOG_LEVEL_ERROR                         (1)
+#define LOG_LEVEL_WARN                          (2)
+#define LOG_LEVEL_INFO                          (3)
+#define LOG_LEVEL_DEBUG                         (4)
+
+#define LOG_LINE_SIZE                           (128U)    /* stack buffer , longer line is cut */
+
+/* rate limit : LOG_RATE_BURST line at once , then one line every LOG_RATE_INTERVAL_MS */
+#define LOG_RATE_BURST                          (8U)
+#define LOG_RATE_INTERVAL_MS                    (50U)
+
+#define LOG_MODULE_ENUM(id, name)               id,
+
+typedef enum
+{
+    LOG_MODULE_LIST(LOG_MODULE_ENUM)
+    LOG_MOD_NUM
+
+} LOG_MODULE_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#if !defined (LOG_LEVEL_MAX) || !defined (_DEBUG_LOG_ENABLE)
+#undef  LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX                           LOG_LEVEL_NONE
+#endif
+
+#if !defined (LOG_MODULE)
+#define LOG_MODULE                              LOG_MOD_APP
+#endif
+
+#if !defined (LOG_MODULE_LEVEL)
+#define LOG_MODULE_LEVEL                        LOG_LEVEL_MAX
+#endif
+
+#if (LOG_MODULE_LEVEL < LOG_LEVEL_MAX)
+#define LOG_LOCAL_LEVEL                         LOG_MODULE_LEVEL
+#else
+#define LOG_LOCAL_LEVEL                         LOG_LEVEL_MAX
+#endif
+
+#if (LOG_LOCAL_LEVEL >= LOG_LEVEL_ERROR)
+#define LOG_E(...)                              Log_Write(LOG_MODULE, LOG_LEVEL_ERROR, __VA_ARGS__)
+#else
+#define LOG_E(...)                              ((void)0)
+#endif
+
+#if (LOG_LOCAL_LEVEL >= LOG_LEVEL_WARN)
+#define LOG_W(...)                              Log_Write(LOG_MODULE, LOG_LEVEL_WARN, __VA_ARGS__)
+#else
+#define LOG_W(...)                              ((void)0)
+#endif
+
+#if (LOG_LOCAL_LEVEL >= LOG_LEVEL_INFO)
+#define LOG_I(...)                              Log_Write(LOG_MODULE, LOG_LEVEL_INFO, __VA_ARGS__)
+#else
+#define LOG_I(...)                              ((void)0)
+#endif
+
+#if (LOG_LOCAL_LEVEL >= LOG_LEVEL_DEBUG)
+#define LOG_D(...)                              Log_Write(LOG_MODULE, LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_D(...)                              ((void)0)
+#endif
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* all module to LOG_LEVEL_MAX , full token bucket */
+void Log_Init(void);
+
+/*
+ * ISR safe , prefix "[tick] L module: " , one write to debug UART
+ * return 0  : sent
+ *        -1 : filtered , rate limited or TX ring full
+ */
+int  Log_Write(unsigned char module, unsigned char level, const char *fmt, ...);
+
+/* runtime level , above LOG_LEVEL_MAX has no effect (code not built) */
+void Log_SetLevel(unsigned char module, unsigned char level);
+void Log_SetLevelAll(unsigned char level);
+unsigned char Log_GetLevel(unsigned char module);
+
+/* line dropped by rate limit */
+unsigned long Log_GetSuppressCnt(unsigned char module);
+
+/* return module id , -1 if name not found */
+int  Log_FindModule(const char *name);
+
+/*
+ * shell command "log" , call after Shell_Init
+ *   log                    : level and suppress count of all module
+ *   log <module|all> <0-4> : set runtime level
+ */
+int  Log_Register(void);
+
+#endif //__LOG_H__
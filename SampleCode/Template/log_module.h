@@ -0,0 +1,16 @@
+#ifndef __LOG_MODULE_H__
+#define __LOG_MODULE_H__
+
+/*
+ * log module table : id , name shown in prefix and used by "log" shell command
+ * compile time level of a module is set in its .c file by LOG_MODULE_LEVEL , see log.h
+ */
+#define LOG_MODULE_LIST(X) \
+    X(LOG_MOD_APP,                  "app")                                                      \
+    X(LOG_MOD_TIMER,                "timer")                                                    \
+    X(LOG_MOD_UART,                 "uart")                                                     \
+    X(LOG_MOD_SHELL,                "shell")                                                    \
+    X(LOG_MOD_TELEM,                "telem")                                                    \
+    X(LOG_MOD_BOOT,                 "boot")                                                     \
+
+#endif //__LOG_MODULE_H__
@@ -1,11 +1,32 @@
 /*_____ I N C L U D E S ____________________________________________________*/
 #include <stdio.h>
 #include <string.h>
+#include <stdlib.h>
 #include "NuMicro.h"
 
 #include "misc_config.h"
 
 #include "timer_service.h"
+#include "pdma_service.h"
+#include "mem_kernel.h"
+#include "crc_service.h"
+#include "boot_verify.h"
+#include "adc_stream.h"
+#include "dsp_filter.h"
+#include "adc_oversample.h"
+#include "pwm_seq.h"
+#include "hdiv_rt.h"
+#include "timer_schedule.h"
+#include "uart_dma.h"
+#include "uart_dma_rx.h"
+#include "uart_async.h"
+#include "telemetry.h"
+#include "binlog.h"
+#include "lite_printf.h"
+#include "uart_rx.h"
+#include "shell.h"
+#include "timer_cli.h"
+#include "log.h"
 
 /*_____ D E C L A R A T I O N S ____________________________________________*/
 
@@ -27,6 +48,9 @@ volatile uint32_t counter_tick = 0;
 
 static int g_timer_id_task1 = -1;
 static int g_timer_id_task2 = -1;
+#if defined (ENABLE_TELEMETRY)
+static int g_timer_id_telemetry = -1;
+#endif
 
 
 /*_____ M A C R O S ________________________________________________________*/
@@ -122,14 +146,76 @@ void Task_1000ms_Callback(void *user_data)
 {
 	static uint32_t cnt = 0;
     PB14 ^= 1;
-    printf("%s:%4lu (1 sec)\r\n",__FUNCTION__, (unsigned long)cnt++);
+    BLOG1(BLOG_ID_TASK_1000MS, cnt++);
 }
 
+#if defined (ENABLE_TELEMETRY)
+static TELEMETRY_PKT_T s_TelemetryStatsPkt;
+static unsigned char s_TelemetryStats[20];
+
+/* TELEMETRY_TYPE_TIMER_STATS payload , little endian */
+void Task_Telemetry_Callback(void *user_data)
+{
+	unsigned char *p = s_TelemetryStats;
+
+	(void)user_data;
+
+	/* previous frame not encoded yet : skip this period */
+	if (Telemetry_IsBusy(&s_TelemetryStatsPkt))
+	{
+		return;
+	}
+
+	TELEMETRY_PUT_U32(&p[0], TimerService_GetTick());
+	p[4] = TimerService_GetQueueMaxUsed();
+	p[5] = TimerService_GetPostMaxUsed();
+	TELEMETRY_PUT_U16(&p[6], (unsigned short)TimerService_GetUtilization());
+	TELEMETRY_PUT_U32(&p[8], TimerService_GetQueueOverflowCnt());
+	TELEMETRY_PUT_U32(&p[12], TimerService_GetPostOverflowCnt());
+	TELEMETRY_PUT_U32(&p[16], TimerService_GetBudgetExhaustedCnt());
+
+	Telemetry_Submit(&s_TelemetryStatsPkt, TELEMETRY_TYPE_TIMER_STATS, s_TelemetryStats, sizeof(s_TelemetryStats));
+}
+#endif
+
 void Task_10ms_Callback(void *user_data)
 {
 
 }
 
+#if defined (ENABLE_TIMER_SCHEDULE)
+void Task_Schedule_1ms(void *user_data)
+{
+    PB15 ^= 1;
+}
+
+void Task_Schedule_2ms(void *user_data)
+{
+
+}
+
+/* minor frame 1 ms , major cycle 2 ms */
+#define SCHEDULE_FRAME0_SLOTS(X)    X(Task_Schedule_1ms, (void *)0, 20U) X(Task_Schedule_2ms, (void *)0, 100U)
+#define SCHEDULE_FRAME1_SLOTS(X)    X(Task_Schedule_1ms, (void *)0, 20U)
+
+TIMER_SCHEDULE_DEFINE_FRAME(g_ScheduleFrame0, SCHEDULE_FRAME0_SLOTS);
+TIMER_SCHEDULE_DEFINE_FRAME(g_ScheduleFrame1, SCHEDULE_FRAME1_SLOTS);
+
+static const TIMER_SCHEDULE_FRAME_T g_ScheduleTable[] =
+{
+    TIMER_SCHEDULE_FRAME(g_ScheduleFrame0),
+    TIMER_SCHEDULE_FRAME(g_ScheduleFrame1),
+};
+
+void TimerSchedule_CreateTable(void)
+{
+    if (TimerSchedule_Init(g_ScheduleTable, (unsigned char)SIZEOF(g_ScheduleTable), TIMER1) == 0)
+    {
+        TimerSchedule_Start();
+    }
+}
+#endif
+
 void TimerService_CreateTask(void)
 {
     /* Create task1 timer: 1000 ms */
@@ -139,9 +225,22 @@ void TimerService_CreateTask(void)
     if (g_timer_id_task1 >= 0)
     {
         TimerService_StartTimer((unsigned int)g_timer_id_task1);
-        printf("task1 id = %d\r\n", g_timer_id_task1);
+        LOG_I("task1 id = %d\r\n", g_timer_id_task1);
     }
 
+    #if defined (ENABLE_TELEMETRY)
+    #if defined (ENABLE_UART_DMA_TX)
+    Telemetry_Init(UartDma_Write);
+    #else
+    Telemetry_Init((TELEMETRY_SINK_T)0);    /* debug UART */
+    #endif
+    g_timer_id_telemetry = TimerService_CreateTimer(100U, Task_Telemetry_Callback, (void *)0);
+    if (g_timer_id_telemetry >= 0)
+    {
+        TimerService_StartTimer((unsigned int)g_timer_id_telemetry);
+    }
+    #endif
+
     /* Create task1 timer: 10 ms */
     g_timer_id_task2 = TimerService_CreateTimer(10U, Task_10ms_Callback, (void *)0);
 
@@ -149,7 +248,7 @@ void TimerService_CreateTask(void)
     if (g_timer_id_task2 >= 0)
     {
         TimerService_StartTimer((unsigned int)g_timer_id_task2);
-        printf("task2 id = %d\r\n", g_timer_id_task2);
+        LOG_I("task2 id = %d\r\n", g_timer_id_task2);
     }
 }
 
@@ -269,6 +368,10 @@ void TMR1_IRQHandler(void)
         TIMER_ClearIntFlag(TIMER1);
 		tick_counter();
 
+        #if defined (ENABLE_TIMER_SCHEDULE)
+        TimerSchedule_Tick1ms();
+        #endif
+
         TimerService_Tick1ms();
 
 		// if ((get_tick() % 1000) == 0)
@@ -294,56 +397,432 @@ void TIMER1_Init(void)
 
 void loop(void)
 {
-    TimerService_Dispatch();
+    /* bounded, leave time for other main loop work */
+    TimerService_DispatchBudget(TIMER_DISPATCH_MAX_EVENTS);
+
+}
+
+/* shell command , executed in TimerService_Dispatch */
+int Cmd_Reset(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	SYS_UnlockReg();
+	// NVIC_SystemReset();	// Reset I/O and peripherals , only check BS(FMC_ISPCTL[1])
+	// SYS_ResetCPU();     // Not reset I/O and peripherals
+	SYS_ResetChip();    // Reset I/O and peripherals ,  BS(FMC_ISPCTL[1]) reload from CONFIG setting (CBS)
+
+	return 0;
+}
+
+#if defined (ENABLE_LITE_PRINTF)
+int Cmd_Bench(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	LitePrintf_Benchmark();
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_MEM_KERNEL_BENCH)
+int Cmd_MemBench(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
 
+	MemKernel_Benchmark();
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_BOOT_VERIFY)
+int Cmd_BootVerify(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	BootVerify_Compare();
+
+	return 0;
 }
+#endif
 
-void UARTx_Process(void)
+#if defined (ENABLE_HDIV_RT)
+int Cmd_HdivBench(int argc, char *argv[])
 {
-	uint8_t res = 0;
-	res = UART_READ(UART0);
+	(void)argc;
+	(void)argv;
+
+	HdivRt_Benchmark();
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_FILTER_BENCH)
+int Cmd_FilterBench(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	DspFilter_Benchmark();
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_ADC_STREAM)
+static volatile unsigned short s_adc_min = 0U;
+static volatile unsigned short s_adc_max = 0U;
+static volatile unsigned short s_adc_avg = 0U;
 
-	if (res > 0x7F)
+/* block consumer , executed in TimerService_Dispatch */
+void AdcStream_Consumer(const unsigned short *sample, unsigned int count, unsigned long seq, void *user_data)
+{
+	unsigned long sum = 0UL;
+	unsigned short lo = 0xFFFFU;
+	unsigned short hi = 0U;
+	unsigned int i;
+
+	(void)seq;
+	(void)user_data;
+
+	for (i = 0U; i < count; i++)
+	{
+		sum += sample[i];
+		lo = (sample[i] < lo) ? sample[i] : lo;
+		hi = (sample[i] > hi) ? sample[i] : hi;
+	}
+
+	s_adc_min = lo;
+	s_adc_max = hi;
+	s_adc_avg = (unsigned short)(sum / count);
+}
+
+int Cmd_Adc(int argc, char *argv[])
+{
+	unsigned long rate;
+	char *end;
+
+	if (argc >= 2)
+	{
+		if (strcmp(argv[1], "stop") == 0)
+		{
+			AdcStream_Stop();
+			return 0;
+		}
+
+		rate = strtoul(argv[1], &end, 0);
+		if ((*end != '\0') || (AdcStream_Start(rate) != 0))
+		{
+			printf("usage : adc [rate_hz|0|stop]\r\n");
+			return -1;
+		}
+	}
+
+	printf("adc %s , block %lu , drop %lu , overrun %lu , min %u max %u avg %u\r\n",
+			AdcStream_IsRunning() ? "run" : "stop",
+			AdcStream_GetBlockCnt(), AdcStream_GetDropCnt(), AdcStream_GetOverrunCnt(),
+			s_adc_min, s_adc_max, s_adc_avg);
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_ADC_OVERSAMPLE)
+int Cmd_AdcOvs(int argc, char *argv[])
+{
+	unsigned long period;
+	unsigned short value;
+	unsigned short seq;
+	unsigned char ch;
+	char *end;
+
+	if (argc >= 2)
+	{
+		if (strcmp(argv[1], "stop") == 0)
+		{
+			AdcOvs_Stop();
+			return 0;
+		}
+
+		period = strtoul(argv[1], &end, 0);
+		if ((*end != '\0') || (period > 0xFFFFUL) || (AdcOvs_Start((unsigned short)period) != 0))
+		{
+			printf("usage : adcovs [period_ms|0|stop]\r\n");
+			return -1;
+		}
+	}
+
+	printf("adcovs %u bit , round %lu , miss %lu\r\n",
+			12U + AdcOvs_GetBits(), AdcOvs_GetRoundCnt(), AdcOvs_GetMissCnt());
+
+	for (ch = 0U; ch < ADC_OVS_CH_NUM; ch++)
 	{
-		printf("invalid command\r\n");
+		seq = AdcOvs_Read(ch, &value);
+		if (seq != 0U)
+		{
+			printf("  ch%2u : %5u (seq %u)\r\n", ch, value, seq);
+		}
+	}
+
+	return 0;
+}
+#endif
+
+#if defined (ENABLE_PWM_SEQ)
+#define PWMSEQ_DEMO_HALF                        (64U)
+
+/* up half then down half , built once per command , PDMA read it while running */
+static unsigned long s_pwmseq_table[PWMSEQ_DEMO_HALF * 2U];
+
+int Cmd_PwmSeq(int argc, char *argv[])
+{
+	unsigned long step_hz = 50UL;
+	unsigned long duty;
+	char *end;
+	int ret = 0;
+
+	if (argc >= 3)
+	{
+		step_hz = strtoul(argv[2], &end, 0);
+		if (*end != '\0')
+		{
+			step_hz = 0UL;
+		}
 	}
-	else
+
+	if (argc >= 2)
 	{
-		printf("press : %c\r\n" , res);
-		switch(res)
+		if (strcmp(argv[1], "stop") == 0)
+		{
+			PwmSeq_Stop();
+		}
+		else if (strcmp(argv[1], "fade") == 0)
+		{
+			PwmSeq_Stop();
+			PwmSeq_BuildRamp(s_pwmseq_table, PWMSEQ_DEMO_HALF, 0U, 1000U, PWM_SEQ_RAMP_SQUARE);
+			ret = PwmSeq_Start(s_pwmseq_table, PWMSEQ_DEMO_HALF, step_hz, PWM_SEQ_ONCE);
+		}
+		else if (strcmp(argv[1], "breathe") == 0)
+		{
+			PwmSeq_Stop();
+			PwmSeq_BuildRamp(&s_pwmseq_table[0], PWMSEQ_DEMO_HALF, 0U, 1000U, PWM_SEQ_RAMP_SQUARE);
+			PwmSeq_BuildRamp(&s_pwmseq_table[PWMSEQ_DEMO_HALF], PWMSEQ_DEMO_HALF, 1000U, 0U, PWM_SEQ_RAMP_SQUARE);
+			ret = PwmSeq_Start(s_pwmseq_table, PWMSEQ_DEMO_HALF * 2U, step_hz, PWM_SEQ_LOOP);
+		}
+		else
 		{
-			case '1':
-				break;
-
-			case 'X':
-			case 'x':
-			case 'Z':
-			case 'z':
-                SYS_UnlockReg();
-				// NVIC_SystemReset();	// Reset I/O and peripherals , only check BS(FMC_ISPCTL[1])
-                // SYS_ResetCPU();     // Not reset I/O and peripherals
-                SYS_ResetChip();    // Reset I/O and peripherals ,  BS(FMC_ISPCTL[1]) reload from CONFIG setting (CBS)	
-				break;
+			duty = strtoul(argv[1], &end, 0);
+			PwmSeq_Stop();
+			ret = ((*end != '\0') || (duty > 1000UL)) ? -1 : PwmSeq_SetDuty((unsigned short)duty);
+		}
+
+		if (ret != 0)
+		{
+			printf("usage : pwmseq [fade|breathe [step_hz]|permille|stop]\r\n");
+			return -1;
 		}
 	}
+
+	printf("pwmseq %s , period %lu clock , pass %lu\r\n",
+			PwmSeq_IsRunning() ? "run" : "stop", PwmSeq_GetPeriod(), PwmSeq_GetPassCnt());
+
+	return 0;
 }
+#endif
+
+#if defined (ENABLE_UART_ASYNC)
+static char s_u1tx_buf[SHELL_LINE_SIZE];
+
+void Uart1_WriteDone(int status, unsigned int count, void *user_data)
+{
+	(void)user_data;
+
+	printf("u1tx done , status %d , %u byte\r\n", status, count);
+}
+
+int Cmd_Uart1Tx(int argc, char *argv[])
+{
+	unsigned int len;
+
+	if (argc < 2)
+	{
+		printf("usage : u1tx <text>\r\n");
+		return -1;
+	}
+
+	/* s_u1tx_buf is read by UART1 ISR until done : never overwrite a running write */
+	if (UART_IsAsyncBusy(UART_ASYNC_PORT_UART1))
+	{
+		printf("u1tx busy\r\n");
+		return -1;
+	}
+
+	/* argv point into shell line buffer , copy before return */
+	len = (unsigned int)strlen(argv[1]);
+	memcpy(s_u1tx_buf, argv[1], len);
+
+	if (UART_WriteAsync(UART_ASYNC_PORT_UART1, (const unsigned char *)s_u1tx_buf, len,
+						100U, Uart1_WriteDone, (void *)0) != 0)
+	{
+		printf("u1tx busy\r\n");
+		return -1;
+	}
+
+	return 0;
+}
+#endif
+
+int Cmd_RxStat(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	printf("rx maxused %u , overflow %lu\r\n", UartRx_GetMaxUsed(), UartRx_GetOverflowCnt());
+
+	return 0;
+}
+
+int Cmd_PdmaStat(int argc, char *argv[])
+{
+	(void)argc;
+	(void)argv;
+
+	printf("pdma channel 0x%03lX , abort %lu , timeout %lu\r\n",
+			PdmaService_GetChannelMask(), PdmaService_GetAbortCnt(), PdmaService_GetTimeoutCnt());
+
+	return 0;
+}
+
+static const SHELL_CMD_T s_AppCmdTable[] =
+{
+	{"reset",   Cmd_Reset,      "chip reset"},
+	{"rxstat",  Cmd_RxStat,     "UART RX ring statistic"},
+	{"pdma",    Cmd_PdmaStat,   "PDMA channel in use , error count"},
+	#if defined (ENABLE_LITE_PRINTF)
+	{"bench",   Cmd_Bench,      "lite printf vs libc cycle"},
+	#endif
+	#if defined (ENABLE_ADC_STREAM)
+	{"adc",     Cmd_Adc,        "adc [rate_hz|0|stop] , timer triggered ADC block stream"},
+	#endif
+	#if defined (ENABLE_ADC_OVERSAMPLE)
+	{"adcovs",  Cmd_AdcOvs,     "adcovs [period_ms|0|stop] , oversampled channel table"},
+	#endif
+	#if defined (ENABLE_PWM_SEQ)
+	{"pwmseq",  Cmd_PwmSeq,     "pwmseq [fade|breathe [step_hz]|permille|stop] , PDMA fed PWM duty table"},
+	#endif
+	#if defined (ENABLE_FILTER_BENCH)
+	{"filterbench", Cmd_FilterBench, "Q15 filter cycle per sample"},
+	#endif
+	#if defined (ENABLE_BOOT_VERIFY)
+	{"bootverify", Cmd_BootVerify, "image CRC + PDMA vs FMC checksum , background pass count"},
+	#endif
+	#if defined (ENABLE_HDIV_RT)
+	{"hdivbench", Cmd_HdivBench, "integer divide cycle , library vs HDIV"},
+	#endif
+	#if defined (ENABLE_MEM_KERNEL_BENCH)
+	{"membench", Cmd_MemBench,  "copy / fill cycle , byte loop vs kernel vs PDMA"},
+	#endif
+	#if defined (ENABLE_UART_ASYNC)
+	{"u1tx",    Cmd_Uart1Tx,    "u1tx <text> , UART1 async write"},
+	#endif
+};
+
+void Shell_CreateCommand(void)
+{
+	const unsigned int n = sizeof(s_AppCmdTable) / sizeof(s_AppCmdTable[0]);
+
+	Shell_Init();
+
+	/* refused : SHELL_MAX_CMDS too small or duplicate name */
+	if (Shell_RegisterTable(s_AppCmdTable, n) != (int)n)
+	{
+		LOG_W("shell : app command refused\r\n");
+	}
+	if (TimerCli_Register() != (int)TIMER_CLI_CMD_NUM)
+	{
+		LOG_W("shell : timer command refused\r\n");
+	}
+	if (Log_Register() != 1)
+	{
+		LOG_W("shell : log command refused\r\n");
+	}
+
+	printf(SHELL_PROMPT);
+}
+
+#if defined (ENABLE_UART_DMA_RX)
+/* frame consumer , executed in TimerService_Dispatch */
+void UartDmaRx_Process(void *user_data)
+{
+	UART_DMA_RX_VIEW_T view;
+
+	(void)user_data;
+
+	UartDmaRx_Rearm();
+
+	while (UartDmaRx_GetFrame(&view) == 0)
+	{
+		LOG_D("rx frame %4u byte , flag 0x%02X , first 0x%02X\r\n",
+					view.len0 + view.len1, (unsigned int)view.flags, (unsigned int)view.data0[0]);
+		UartDmaRx_ReleaseFrame();
+	}
+}
+#endif
 
 void UART02_IRQHandler(void)
 {
     if(UART_GET_INT_FLAG(UART0, UART_INTSTS_RDAINT_Msk | UART_INTSTS_RXTOINT_Msk))     /* UART receive data available flag */
     {
-        while(UART_GET_RX_EMPTY(UART0) == 0)
+        #if defined (ENABLE_UART_DMA_RX)
+        /* first byte after idle : RX back to PDMA */
+        if (UartDmaRx_WakeFromISR() == 0)
+        #endif
         {
-			UARTx_Process();
+            /* copy FIFO only , shell run in main loop , off while ENABLE_UART_DMA_RX own RX */
+            UartRx_IRQHandler();
         }
     }
 
+    #if defined (DEBUG_TX_IRQ)
+    if(UART_GET_INT_FLAG(UART0, UART_INTSTS_THREINT_Msk))      /* printf TX ring drain */
+    {
+        DebugTx_IRQHandler();
+    }
+    #endif
+
     if(UART0->FIFOSTS & (UART_FIFOSTS_BIF_Msk | UART_FIFOSTS_FEF_Msk | UART_FIFOSTS_PEF_Msk | UART_FIFOSTS_RXOVIF_Msk))
     {
         UART_ClearIntFlag(UART0, (UART_INTSTS_RLSINT_Msk| UART_INTSTS_BUFERRINT_Msk));
     }	
 }
 
+#if defined (ENABLE_UART_ASYNC)
+void UART13_IRQHandler(void)
+{
+    UartAsync_IRQHandler(UART_ASYNC_PORT_UART1);
+}
+
+void UART1_Init(void)
+{
+    SYS_ResetModule(UART1_RST);
+
+    /* RXD PB.2 / TXD PB.3 set in SYS_Init */
+    UART_Open(UART1, 115200);
+}
+#endif
+
+void PDMA_IRQHandler(void)
+{
+    PdmaService_IRQHandler();
+}
+
 void UART0_Init(void)
 {
     SYS_ResetModule(UART0_RST);
@@ -406,11 +885,69 @@ void SYS_Init(void)
 	/***********************************/
     CLK_EnableModuleClock(UART0_MODULE);
     CLK_SetModuleClock(UART0_MODULE, CLK_CLKSEL1_UART0SEL_HIRC, CLK_CLKDIV0_UART0(1));
+
+    #if defined (ENABLE_UART_ASYNC)
+    CLK_EnableModuleClock(UART1_MODULE);
+    CLK_SetModuleClock(UART1_MODULE, CLK_CLKSEL1_UART1SEL_HIRC, CLK_CLKDIV0_UART1(1));
+
+    /* Set PB multi-function pins for UART1 RXD=PB.2 and TXD=PB.3 */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB2MFP_Msk | SYS_GPB_MFPL_PB3MFP_Msk)) |
+                    (SYS_GPB_MFPL_PB2MFP_UART1_RXD | SYS_GPB_MFPL_PB3MFP_UART1_TXD);
+    #endif
 	
     /* Set PB multi-function pins for UART0 RXD=PB.12 and TXD=PB.13 */
     SYS->GPB_MFPH = (SYS->GPB_MFPH & ~(SYS_GPB_MFPH_PB12MFP_Msk | SYS_GPB_MFPH_PB13MFP_Msk)) |
                     (SYS_GPB_MFPH_PB12MFP_UART0_RXD | SYS_GPB_MFPH_PB13MFP_UART0_TXD);
 
+    CLK_EnableModuleClock(PDMA_MODULE);
+
+    #if defined (ENABLE_LITE_PRINTF) || defined (ENABLE_HDIV_RT)
+    CLK_EnableModuleClock(HDIV_MODULE);
+    #endif
+
+    #if defined (ENABLE_HDIV_RT)
+    HdivRt_Enable(1U);
+    #endif
+
+    #if defined (ENABLE_CRC_SERVICE)
+    CLK_EnableModuleClock(CRC_MODULE);
+    #endif
+
+    #if defined (ENABLE_ADC_STREAM) || defined (ENABLE_ADC_OVERSAMPLE)
+    /* ADC clock PCLK1 / 2 */
+    CLK_EnableModuleClock(ADC_MODULE);
+    CLK_SetModuleClock(ADC_MODULE, CLK_CLKSEL2_ADCSEL_PCLK1, CLK_CLKDIV0_ADC(2));
+
+    /* PB.0 ADC0_CH0 , analog input , digital path off */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB0MFP_Msk)) | (SYS_GPB_MFPL_PB0MFP_ADC0_CH0);
+    GPIO_SetMode(PB, BIT0, GPIO_MODE_INPUT);
+    GPIO_DISABLE_DIGITAL_PATH(PB, BIT0);
+    #endif
+
+    #if defined (ENABLE_ADC_STREAM)
+    /* TIMER2 as ADC trigger */
+    CLK_EnableModuleClock(TMR2_MODULE);
+    CLK_SetModuleClock(TMR2_MODULE, CLK_CLKSEL1_TMR2SEL_HIRC, 0);
+    #endif
+
+    #if defined (ENABLE_ADC_OVERSAMPLE)
+    /* PB.1 ADC0_CH1 */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB1MFP_Msk)) | (SYS_GPB_MFPL_PB1MFP_ADC0_CH1);
+    GPIO_SetMode(PB, BIT1, GPIO_MODE_INPUT);
+    GPIO_DISABLE_DIGITAL_PATH(PB, BIT1);
+    #endif
+
+    #if defined (ENABLE_PWM_SEQ)
+    /* PWM0 from PCLK0 , TIMER3 as step clock */
+    CLK_EnableModuleClock(PWM0_MODULE);
+    CLK_SetModuleClock(PWM0_MODULE, CLK_CLKSEL2_PWM0SEL_PCLK0, 0);
+    CLK_EnableModuleClock(TMR3_MODULE);
+    CLK_SetModuleClock(TMR3_MODULE, CLK_CLKSEL1_TMR3SEL_HIRC, 0);
+
+    /* PB.5 PWM0_CH0 */
+    SYS->GPB_MFPL = (SYS->GPB_MFPL & ~(SYS_GPB_MFPL_PB5MFP_Msk)) | (SYS_GPB_MFPL_PB5MFP_PWM0_CH0);
+    #endif
+
 	/***********************************/
    /* Update System Core Clock */
     SystemCoreClockUpdate();
@@ -443,8 +980,64 @@ int main()
     #endif
 
     TimerService_Init();
+    Log_Init();
+    PdmaService_Init();
+
+    #if defined (ENABLE_UART_DMA_TX)
+    UartDma_Init();
+    #endif
+
+    #if defined (ENABLE_UART_DMA_RX)
+    UartDmaRx_Init(UartDmaRx_Process, (void *)0);
+    #endif
+
+    MemKernel_Init();
+
+    #if defined (ENABLE_CRC_SERVICE)
+    CrcService_Init();
+    #endif
+
+    #if defined (ENABLE_BOOT_VERIFY)
+    if (BootVerify_Boot() == BOOT_VERIFY_OK)
+    {
+        (void)BootVerify_StartBackground(BOOT_VERIFY_BG_PERIOD_MS);
+    }
+    #endif
+
+    #if defined (ENABLE_ADC_OVERSAMPLE)
+    if (AdcOvs_Init(ADC_OVS_CH_MASK, 2U, 0U) != 0)
+    {
+        LOG_W("adc oversample : init fail\r\n");
+    }
+    #endif
+
+    #if defined (ENABLE_ADC_STREAM)
+    if (AdcStream_Init(AdcStream_Consumer, (void *)0) != 0)
+    {
+        LOG_W("adc stream : no PDMA channel\r\n");
+    }
+    #endif
+
+    #if defined (ENABLE_PWM_SEQ)
+    if (PwmSeq_Init(1000UL, (PWM_SEQ_CALLBACK_T)0, (void *)0) != 0)
+    {
+        LOG_W("pwm seq : init fail\r\n");
+    }
+    #endif
+
     TimerService_CreateTask();
 
+    #if defined (ENABLE_UART_ASYNC)
+    UART1_Init();
+    UartAsync_Init();
+    #endif
+
+    Shell_CreateCommand();
+
+    #if defined (ENABLE_TIMER_SCHEDULE)
+    TimerSchedule_CreateTable();
+    #endif
+
     /* Got no where to go, just loop forever */
     while(1)
     {
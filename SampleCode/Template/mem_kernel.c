@@ -0,0 +1,503 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "mem_kernel.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static int g_MemKernelCh = -1;
+
+#if defined (ENABLE_MEM_KERNEL_BENCH)
+static const unsigned short s_MemKernelBenchSize[] = {16U, 64U, 256U, 1024U, 2048U};
+
+static unsigned long s_MemKernelBenchSrc[(2048U / 4U) + 1U];
+static unsigned long s_MemKernelBenchDst[2048U / 4U];
+
+static volatile unsigned char s_MemKernelBenchDone = 0U;
+#endif
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define MEM_KERNEL_ENTER_CRITICAL(m)            do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define MEM_KERNEL_EXIT_CRITICAL(m)             __set_PRIMASK(m)
+
+#define MEM_KERNEL_ADDR(p)                      ((unsigned long)(p))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+int MemKernel_GetChannel(void)
+{
+    return g_MemKernelCh;
+}
+
+/* dst word aligned , src any offset : aligned word load , shift merge , return byte left */
+static unsigned long MemKernel_CopyShift(unsigned long **pdw, const unsigned char **ps, unsigned long len)
+{
+    unsigned long *dw;
+    const unsigned long *sw;
+    unsigned long prev;
+    unsigned long next;
+    unsigned long lo;
+    unsigned long hi;
+
+    dw = *pdw;
+    lo = (MEM_KERNEL_ADDR(*ps) & 3UL) * 8UL;
+    hi = 32UL - lo;
+
+    /* word holding first / last byte is always readable , no access beyond that word */
+    sw   = (const unsigned long *)(MEM_KERNEL_ADDR(*ps) & ~3UL);
+    prev = *sw++;
+
+    while (len >= 4UL)
+    {
+        next  = *sw++;
+        *dw++ = (prev >> lo) | (next << hi);
+        prev  = next;
+        len  -= 4UL;
+        *ps  += 4;
+    }
+
+    *pdw = dw;
+
+    return len;
+}
+
+void MemKernel_Copy(void *dst, const void *src, unsigned long len)
+{
+    unsigned char *d;
+    const unsigned char *s;
+    unsigned long *dw;
+    const unsigned long *sw;
+    unsigned long w0;
+    unsigned long w1;
+    unsigned long w2;
+    unsigned long w3;
+
+    d = (unsigned char *)dst;
+    s = (const unsigned char *)src;
+
+    if (len >= 8UL)
+    {
+        while ((MEM_KERNEL_ADDR(d) & 3UL) != 0UL)
+        {
+            *d++ = *s++;
+            len--;
+        }
+
+        dw = (unsigned long *)d;
+
+        if ((MEM_KERNEL_ADDR(s) & 3UL) == 0UL)
+        {
+            sw = (const unsigned long *)s;
+
+            /* 4 load then 4 store : LDM / STM */
+            while (len >= 16UL)
+            {
+                w0 = sw[0];
+                w1 = sw[1];
+                w2 = sw[2];
+                w3 = sw[3];
+                dw[0] = w0;
+                dw[1] = w1;
+                dw[2] = w2;
+                dw[3] = w3;
+                sw  += 4;
+                dw  += 4;
+                len -= 16UL;
+            }
+
+            while (len >= 4UL)
+            {
+                *dw++ = *sw++;
+                len  -= 4UL;
+            }
+
+            s = (const unsigned char *)sw;
+        }
+        else
+        {
+            len = MemKernel_CopyShift(&dw, &s, len);
+        }
+
+        d = (unsigned char *)dw;
+    }
+
+    while (len != 0UL)
+    {
+        *d++ = *s++;
+        len--;
+    }
+}
+
+void MemKernel_Fill(void *dst, unsigned char val, unsigned long len)
+{
+    unsigned char *d;
+    unsigned long *dw;
+    unsigned long w;
+
+    d = (unsigned char *)dst;
+
+    if (len >= 8UL)
+    {
+        while ((MEM_KERNEL_ADDR(d) & 3UL) != 0UL)
+        {
+            *d++ = val;
+            len--;
+        }
+
+        w  = (unsigned long)val * 0x01010101UL;
+        dw = (unsigned long *)d;
+
+        while (len >= 16UL)
+        {
+            dw[0] = w;
+            dw[1] = w;
+            dw[2] = w;
+            dw[3] = w;
+            dw  += 4;
+            len -= 16UL;
+        }
+
+        while (len >= 4UL)
+        {
+            *dw++ = w;
+            len  -= 4UL;
+        }
+
+        d = (unsigned char *)dw;
+    }
+
+    while (len != 0UL)
+    {
+        *d++ = val;
+        len--;
+    }
+}
+
+int MemKernel_Compare(const void *a, const void *b, unsigned long len)
+{
+    const unsigned char *pa;
+    const unsigned char *pb;
+    const unsigned long *wa;
+    const unsigned long *wb;
+
+    pa = (const unsigned char *)a;
+    pb = (const unsigned char *)b;
+
+    if ((len >= 8UL) && (((MEM_KERNEL_ADDR(pa) ^ MEM_KERNEL_ADDR(pb)) & 3UL) == 0UL))
+    {
+        while ((MEM_KERNEL_ADDR(pa) & 3UL) != 0UL)
+        {
+            if (*pa != *pb)
+            {
+                return (int)*pa - (int)*pb;
+            }
+            pa++;
+            pb++;
+            len--;
+        }
+
+        wa = (const unsigned long *)pa;
+        wb = (const unsigned long *)pb;
+
+        /* stop at first different word , byte loop below find the byte */
+        while ((len >= 4UL) && (*wa == *wb))
+        {
+            wa++;
+            wb++;
+            len -= 4UL;
+        }
+
+        pa = (const unsigned char *)wa;
+        pb = (const unsigned char *)wb;
+    }
+
+    while (len != 0UL)
+    {
+        if (*pa != *pb)
+        {
+            return (int)*pa - (int)*pb;
+        }
+        pa++;
+        pb++;
+        len--;
+    }
+
+    return 0;
+}
+
+static void MemKernel_DmaDone(int status, unsigned long count, void *user_data)
+{
+    MEM_KERNEL_REQ_T *req;
+
+    (void)count;
+
+    req = (MEM_KERNEL_REQ_T *)user_data;
+
+    if (req->callback != (MEM_KERNEL_CALLBACK_T)0)
+    {
+        req->callback(status, req->user_data);
+    }
+}
+
+static int MemKernel_Submit(MEM_KERNEL_REQ_T *req, unsigned long src, unsigned long dst, unsigned long words,
+                            unsigned long sar, MEM_KERNEL_CALLBACK_T callback, void *user_data)
+{
+    req->dma.src        = src;
+    req->dma.dst        = dst;
+    req->dma.count      = words;
+    req->dma.ctl        = PDMA_WIDTH_32 | sar | PDMA_DAR_INC | PDMA_REQ_BURST | MEM_KERNEL_DMA_BURST;
+    req->dma.desc       = (DSCT_T *)0;
+    req->dma.periph     = PDMA_MEM;
+    req->dma.timeout_ms = 0U;
+    req->dma.callback   = MemKernel_DmaDone;
+    req->dma.user_data  = (void *)req;
+    req->callback       = callback;
+    req->user_data      = user_data;
+
+    return (PdmaService_Submit((unsigned char)g_MemKernelCh, &req->dma) == 0) ? MEM_KERNEL_ASYNC_QUEUED : -1;
+}
+
+int MemKernel_CopyAsync(MEM_KERNEL_REQ_T *req, void *dst, const void *src, unsigned long len,
+                        MEM_KERNEL_CALLBACK_T callback, void *user_data)
+{
+    unsigned char *d;
+    const unsigned char *s;
+    unsigned long head;
+    unsigned long words;
+
+    if (req->dma.state != PDMA_SERVICE_REQ_IDLE)
+    {
+        return -1;
+    }
+
+    d = (unsigned char *)dst;
+    s = (const unsigned char *)src;
+
+    head  = (4UL - (MEM_KERNEL_ADDR(d) & 3UL)) & 3UL;
+    words = (len > head) ? ((len - head) >> 2) : 0UL;
+
+    /* different word offset : PDMA byte width is slower than CPU shift merge */
+    if ((g_MemKernelCh < 0) || (len < MEM_KERNEL_DMA_THRESHOLD) || (words > MEM_KERNEL_DMA_MAX) ||
+        (((MEM_KERNEL_ADDR(d) ^ MEM_KERNEL_ADDR(s)) & 3UL) != 0UL))
+    {
+        MemKernel_Copy(dst, src, len);
+        return MEM_KERNEL_ASYNC_DONE;
+    }
+
+    /* head / tail byte now , word part by PDMA */
+    MemKernel_Copy(d, s, head);
+    MemKernel_Copy(d + head + (words << 2), s + head + (words << 2), len - head - (words << 2));
+
+    return MemKernel_Submit(req, MEM_KERNEL_ADDR(s + head), MEM_KERNEL_ADDR(d + head), words,
+                            PDMA_SAR_INC, callback, user_data);
+}
+
+int MemKernel_FillAsync(MEM_KERNEL_REQ_T *req, void *dst, unsigned char val, unsigned long len,
+                        MEM_KERNEL_CALLBACK_T callback, void *user_data)
+{
+    unsigned char *d;
+    unsigned long head;
+    unsigned long words;
+
+    if (req->dma.state != PDMA_SERVICE_REQ_IDLE)
+    {
+        return -1;
+    }
+
+    d = (unsigned char *)dst;
+
+    head  = (4UL - (MEM_KERNEL_ADDR(d) & 3UL)) & 3UL;
+    words = (len > head) ? ((len - head) >> 2) : 0UL;
+
+    if ((g_MemKernelCh < 0) || (len < MEM_KERNEL_DMA_THRESHOLD) || (words > MEM_KERNEL_DMA_MAX))
+    {
+        MemKernel_Fill(dst, val, len);
+        return MEM_KERNEL_ASYNC_DONE;
+    }
+
+    MemKernel_Fill(d, val, head);
+    MemKernel_Fill(d + head + (words << 2), val, len - head - (words << 2));
+
+    /* fixed source : PDMA read pattern word from req */
+    req->pattern = (unsigned long)val * 0x01010101UL;
+
+    return MemKernel_Submit(req, MEM_KERNEL_ADDR(&req->pattern), MEM_KERNEL_ADDR(d + head), words,
+                            PDMA_SAR_FIX, callback, user_data);
+}
+
+void MemKernel_Init(void)
+{
+    g_MemKernelCh = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, (PDMA_SERVICE_HOOK_T)0, (void *)0);
+}
+
+#if defined (ENABLE_MEM_KERNEL_BENCH)
+/* reference : old copy_buffer / reset_buffer , volatile keep compiler from turning loop into memcpy */
+static void MemKernel_ByteCopy(void *dst, const void *src, unsigned long len)
+{
+    volatile unsigned char *d;
+    const unsigned char *s;
+
+    d = (volatile unsigned char *)dst;
+    s = (const unsigned char *)src;
+
+    while (len--)
+    {
+        *d++ = *s++;
+    }
+}
+
+static void MemKernel_ByteFill(void *dst, unsigned char val, unsigned long len)
+{
+    volatile unsigned char *d;
+
+    d = (volatile unsigned char *)dst;
+
+    while (len--)
+    {
+        *d++ = val;
+    }
+}
+
+/* op : 0 byte copy , 1 memcpy , 2 kernel copy , 3 kernel copy src + 1 , 4 byte fill , 5 memset , 6 kernel fill */
+static unsigned long MemKernel_BenchCpu(unsigned char op, unsigned long len)
+{
+    unsigned char *src;
+    unsigned char *dst;
+    uint32_t primask;
+    unsigned long start;
+    unsigned long cyc;
+
+    src = (unsigned char *)s_MemKernelBenchSrc;
+    dst = (unsigned char *)s_MemKernelBenchDst;
+
+    MEM_KERNEL_ENTER_CRITICAL(primask);
+
+    start = get_systick_cycle();
+
+    switch (op)
+    {
+        case 0U: MemKernel_ByteCopy(dst, src, len);     break;
+        case 1U: memcpy(dst, src, len);                 break;
+        case 2U: MemKernel_Copy(dst, src, len);         break;
+        case 3U: MemKernel_Copy(dst, src + 1, len);     break;
+        case 4U: MemKernel_ByteFill(dst, 0x5AU, len);   break;
+        case 5U: memset(dst, 0x5A, len);                break;
+        default: MemKernel_Fill(dst, 0x5AU, len);       break;
+    }
+
+    cyc = get_systick_cycle() - start;
+
+    MEM_KERNEL_EXIT_CRITICAL(primask);
+
+    return cyc;
+}
+
+static void MemKernel_BenchHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    (void)ch;
+    (void)user_data;
+
+    s_MemKernelBenchDone = event;
+}
+
+/* setup + transfer + done IRQ , interrupt stay enabled , return 0 if PDMA fail */
+static unsigned long MemKernel_BenchDma(unsigned char ch, unsigned long len)
+{
+    unsigned long start;
+    unsigned long cyc;
+
+    s_MemKernelBenchDone = 0U;
+
+    start = get_systick_cycle();
+
+    PDMA->CHCTL |= (1UL << ch);
+    PDMA_SetTransferCnt(PDMA, ch, PDMA_WIDTH_32, len >> 2);
+    PDMA_SetTransferAddr(PDMA, ch, (uint32_t)s_MemKernelBenchSrc, PDMA_SAR_INC,
+                         (uint32_t)s_MemKernelBenchDst, PDMA_DAR_INC);
+    PDMA_SetTransferMode(PDMA, ch, PDMA_MEM, FALSE, 0);
+    PDMA_SetBurstType(PDMA, ch, PDMA_REQ_BURST, MEM_KERNEL_DMA_BURST);
+    PDMA_EnableInt(PDMA, ch, PDMA_INT_TRANS_DONE);
+    PDMA_Trigger(PDMA, ch);
+
+    while (s_MemKernelBenchDone == 0U)
+    {
+    }
+
+    cyc = get_systick_cycle() - start;
+
+    PDMA_DisableInt(PDMA, ch, PDMA_INT_TRANS_DONE);
+
+    return (s_MemKernelBenchDone == PDMA_SERVICE_EVT_DONE) ? cyc : 0UL;
+}
+
+void MemKernel_Benchmark(void)
+{
+    unsigned long r[8];
+    unsigned long len;
+    unsigned int i;
+    unsigned int k;
+    unsigned char op;
+    int ch;
+
+    for (i = 0U; i < sizeof(s_MemKernelBenchSrc); i++)
+    {
+        ((unsigned char *)s_MemKernelBenchSrc)[i] = (unsigned char)(i * 7U + 1U);
+    }
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, MemKernel_BenchHook, (void *)0);
+
+    dbg_printf("size : copy byte / memcpy / kernel / src+1 / pdma , fill byte / memset / kernel (cycle)\r\n");
+
+    for (i = 0U; i < (sizeof(s_MemKernelBenchSize) / sizeof(s_MemKernelBenchSize[0])); i++)
+    {
+        len = s_MemKernelBenchSize[i];
+
+        for (op = 0U; op < 8U; op++)
+        {
+            r[op] = 0UL;
+        }
+
+        for (k = 0U; k < MEM_KERNEL_BENCH_LOOP; k++)
+        {
+            for (op = 0U; op < 7U; op++)
+            {
+                r[op] += MemKernel_BenchCpu(op, len);
+            }
+
+            if (ch >= 0)
+            {
+                r[7] += MemKernel_BenchDma((unsigned char)ch, len);
+            }
+        }
+
+        for (op = 0U; op < 8U; op++)
+        {
+            r[op] /= MEM_KERNEL_BENCH_LOOP;
+        }
+
+        dbg_printf("%4lu : %5lu %5lu %5lu %5lu %5lu , %5lu %5lu %5lu\r\n",
+                   len, r[0], r[1], r[2], r[3], r[7], r[4], r[5], r[6]);
+    }
+
+    if (ch >= 0)
+    {
+        PdmaService_FreeChannel((unsigned char)ch);
+    }
+    else
+    {
+        dbg_printf("no PDMA channel left , pdma column 0\r\n");
+    }
+
+    MemKernel_Copy((unsigned char *)s_MemKernelBenchDst + 1, (unsigned char *)s_MemKernelBenchSrc + 2, 2045U);
+    if (MemKernel_Compare((unsigned char *)s_MemKernelBenchDst + 1, (unsigned char *)s_MemKernelBenchSrc + 2, 2045U) != 0)
+    {
+        dbg_printf("kernel copy mismatch\r\n");
+    }
+}
+#endif
@@ -0,0 +1,77 @@
+#ifndef __MEM_KERNEL_H__
+#define __MEM_KERNEL_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "pdma_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * memory copy / fill / compare
+ *
+ * CPU kernel   : byte head to word boundary , 16 byte per loop (4 load then 4 store , LDM / STM) , byte tail
+ *                src / dst not on same word offset : aligned load + shift merge , never unaligned access
+ * async kernel : word part of block >= MEM_KERNEL_DMA_THRESHOLD by PDMA memory to memory ,
+ *                head / tail byte by CPU before submit , callback from PdmaService (TimerService_Dispatch)
+ *
+ * src / dst must not overlap
+ */
+#define MEM_KERNEL_DMA_THRESHOLD                (256U)    /* byte , below : PDMA setup + IRQ cost more than CPU copy */
+#define MEM_KERNEL_DMA_MAX                      (65536UL) /* PDMA transfer unit per request */
+#define MEM_KERNEL_DMA_BURST                    (PDMA_BURST_16)     /* let UART channel in every 16 word */
+
+/* MemKernel_CopyAsync / MemKernel_FillAsync return */
+#define MEM_KERNEL_ASYNC_QUEUED                 (0)       /* callback later */
+#define MEM_KERNEL_ASYNC_DONE                   (1)       /* done by CPU , no callback */
+
+#define MEM_KERNEL_BENCH_LOOP                   (8U)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* status is PDMA_SERVICE_x */
+typedef void (*MEM_KERNEL_CALLBACK_T)(int status, void *user_data);
+
+/* caller owned , must stay valid until callback */
+typedef struct _mem_kernel_req_t
+{
+    PDMA_SERVICE_REQ_T      dma;
+    unsigned long           pattern;    /* fill source word , PDMA_SAR_FIX */
+    MEM_KERNEL_CALLBACK_T   callback;
+    void                   *user_data;
+
+} MEM_KERNEL_REQ_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define MemKernel_IsBusy(req)                   PdmaService_IsBusy(&(req)->dma)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after PdmaService_Init , no channel left : async kernel run on CPU */
+void MemKernel_Init(void);
+
+void MemKernel_Copy(void *dst, const void *src, unsigned long len);
+void MemKernel_Fill(void *dst, unsigned char val, unsigned long len);
+
+/* memcmp result */
+int  MemKernel_Compare(const void *a, const void *b, unsigned long len);
+
+/*
+ * ISR safe
+ * return MEM_KERNEL_ASYNC_QUEUED , MEM_KERNEL_ASYNC_DONE , -1 if req busy
+ */
+int  MemKernel_CopyAsync(MEM_KERNEL_REQ_T *req, void *dst, const void *src, unsigned long len,
+                         MEM_KERNEL_CALLBACK_T callback, void *user_data);
+int  MemKernel_FillAsync(MEM_KERNEL_REQ_T *req, void *dst, unsigned char val, unsigned long len,
+                         MEM_KERNEL_CALLBACK_T callback, void *user_data);
+
+/* -1 : CPU only */
+int  MemKernel_GetChannel(void);
+
+/* ENABLE_MEM_KERNEL_BENCH , cycles per call of byte loop / libc / kernel / PDMA , 16 .. 2048 byte , print to debug UART */
+void MemKernel_Benchmark(void);
+
+#endif //__MEM_KERNEL_H__
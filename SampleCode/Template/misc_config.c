@@ -1,5 +1,10 @@
 /*_____ I N C L U D E S ____________________________________________________*/
 #include "misc_config.h"
+#include "mem_kernel.h"
+
+#if defined (ENABLE_UART_DMA_TX)
+#include "uart_dma.h"
+#endif
 
 /*_____ D E C L A R A T I O N S ____________________________________________*/
 
@@ -34,6 +39,30 @@ volatile unsigned char _sys_uTimerEventCount = 0;             /* Speed up interr
 
 /*_____ F U N C T I O N S __________________________________________________*/
 
+unsigned long get_systick_cycle(void)
+{
+    uint32_t primask;
+    unsigned long tick;
+    unsigned long val;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    tick = get_systick();
+    val  = SysTick->VAL;
+
+    /* counter reloaded , SysTick_Handler not run yet */
+    if (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)
+    {
+        tick++;
+        val = SysTick->VAL;
+    }
+
+    __set_PRIMASK(primask);
+
+    return (tick * (SysTick->LOAD + 1UL)) + (SysTick->LOAD - val);
+}
+
 void read_64_words(unsigned long start_addr , unsigned long* buffer)
 {
     unsigned long i = 0;
@@ -58,7 +87,7 @@ unsigned char _read_memory_u08 (const unsigned long addr_u32)
 
 int compare_buffer(const void *src, const void *dest, size_t nBytes)
 {
-    if (memcmp(src, dest, nBytes) == 0) {
+    if (MemKernel_Compare(src, dest, nBytes) == 0) {
         dbg_printf("compare_buffer complete\r\n");
         return 0;
     }
@@ -69,36 +98,12 @@ int compare_buffer(const void *src, const void *dest, size_t nBytes)
 
 void reset_buffer(void *dest, unsigned long val, unsigned long size)
 {
-    unsigned char *pu8Dest;
-//    unsigned lpng i;
-    
-    pu8Dest = (unsigned char *)dest;
-
-	#if 1
-	while (size-- > 0)
-		*pu8Dest++ = val;
-	#else
-	memset(pu8Dest, val, size * (sizeof(pu8Dest[0]) ));
-	#endif
-	
+    MemKernel_Fill(dest, (unsigned char)val, size);
 }
 
 void copy_buffer(void *dest, void *src, unsigned long size)
 {
-    unsigned char *pu8Src, *pu8Dest;
-    unsigned long i;
-    
-    pu8Dest = (unsigned char *)dest;
-    pu8Src  = (unsigned char *)src;
-
-
-	#if 0
-	  while (size--)
-	    *pu8Dest++ = *pu8Src++;
-	#else
-    for (i = 0; i < size; i++)
-        pu8Dest[i] = pu8Src[i];
-	#endif
+    MemKernel_Copy(dest, src, size);
 }
 
 
@@ -198,6 +203,37 @@ void dump_buffer8(unsigned char *pucBuff, int nBytes)
     dbg_printf("\r\n\r\n");
 }
 
+#if defined (ENABLE_UART_DMA_TX)
+/* format one line at a time, transmit by PDMA double buffer */
+void dump_buffer8_hex(unsigned char *pucBuff, int nBytes)
+{
+    char line[80];
+    int nIdx, i, n;
+
+    nIdx = 0;
+    while (nBytes > 0)
+    {
+        n = sprintf(line, "0x%04X  ", nIdx);
+        for (i = 0; i < 16; i++)
+            n += sprintf(&line[n], "%02X ", pucBuff[nIdx + i]);
+        line[n++] = ' ';
+        line[n++] = ' ';
+        for (i = 0; i < 16; i++)
+        {
+            if ((pucBuff[nIdx + i] >= 0x20) && (pucBuff[nIdx + i] < 127))
+                line[n++] = (char)pucBuff[nIdx + i];
+            else
+                line[n++] = '.';
+            nBytes--;
+        }
+        line[n++] = '\r';
+        line[n++] = '\n';
+        nIdx += 16;
+        UartDma_WriteAll((const unsigned char *)line, (unsigned int)n);
+    }
+    UartDma_WriteAll((const unsigned char *)"\r\n", 2U);
+}
+#else
 void dump_buffer8_hex(unsigned char *pucBuff, int nBytes)
 {
     int nIdx, i;
@@ -222,6 +258,7 @@ void dump_buffer8_hex(unsigned char *pucBuff, int nBytes)
     }
     dbg_printf("\n");
 }
+#endif
 
 #if defined (ENABLE_TICK_EVENT)
 void TickCallback_processB(void)
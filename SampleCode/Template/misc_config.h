@@ -4,6 +4,7 @@
 /*_____ I N C L U D E S ____________________________________________________*/
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 
 /*_____ D E C L A R A T I O N S ____________________________________________*/
 
@@ -84,10 +85,52 @@ struct flag_32bit
 
 // #define ENABLE_TICK_EVENT
 
+// #define ENABLE_TIMER_SCHEDULE
+
+// #define ENABLE_UART_DMA_TX
+
+// #define ENABLE_UART_DMA_RX    /* UART0 RX by PDMA frame , shell get no input */
+
+// #define ENABLE_UART_ASYNC     /* UART1 / USCI UART non-blocking write / read */
+
+// #define ENABLE_ADC_STREAM     /* TIMER2 triggered ADC , PDMA ping-pong block , shell adc */
+
+// #define ENABLE_ADC_OVERSAMPLE /* ADC 4^n oversample + decimate , round robin , shell adcovs , not with ENABLE_ADC_STREAM */
+
+// #define ENABLE_PWM_SEQ        /* PB.5 PWM0_CH0 duty table by TIMER3 triggered PDMA , shell pwmseq */
+
+// #define ENABLE_FILTER_BENCH   /* shell filterbench , dsp_filter.c cycle per sample , host : Tools/filter_bench.c */
+
+// #define ENABLE_MEM_KERNEL_BENCH   /* shell membench , 4 KB static buffer */
+
+// #define ENABLE_HDIV_RT        /* 32 / 16 bit "/" and "%" of runtime library by HDIV , shell hdivbench */
+
+// #define ENABLE_TELEMETRY      /* COBS + CRC-32 frame of TimerService statistic , decode with Tools/telemetry_decode.c */
+
+// #define ENABLE_BOOT_VERIFY    /* APROM CRC-32 against trailer (Tools/boot_trailer.c) at boot + background , shell bootverify */
+
+// #define ENABLE_CRC_SERVICE    /* CRC engine shared by context , PDMA feed , on with any CRC user below */
+
+#if (defined (ENABLE_TELEMETRY) || defined (ENABLE_BOOT_VERIFY)) && !defined (ENABLE_CRC_SERVICE)
+#define ENABLE_CRC_SERVICE
+#endif
+
 #define _DEBUG_LOG_ENABLE
 
+/* LOG_x() compile time ceiling : 0 none , 1 error , 2 warn , 3 info , 4 debug (log.h) */
+#define LOG_LEVEL_MAX                               (4)
+
+// #define _DEBUG_LOG_BINARY    /* BLOGx() send id + argument only, decode with Tools/binlog_decode.c */
+
+// #define ENABLE_LITE_PRINTF   /* dbg_printf use lite_printf.c (HDIV, no libc printf) */
+
 #ifdef _DEBUG_LOG_ENABLE
+#if defined (ENABLE_LITE_PRINTF)
+#include "lite_printf.h"
+#define dbg_printf      					LitePrintf_Printf
+#else
 #define dbg_printf      					printf
+#endif
 // #define dbg_printf(format, args...) 			printf("[dbg]"format , ##args)
 // #define dbg_printf(format, args...) 			printf("\033[1;36m" "[log]" format "\033[0m", ##args)
 #else
@@ -179,6 +222,29 @@ struct flag_32bit
 
 /*_____ F U N C T I O N S __________________________________________________*/
 
+#if defined (DEBUG_TX_IRQ)
+/* retarget.c : interrupt-driven printf TX ring */
+void DebugTx_IRQHandler(void);
+uint32_t DebugTx_GetDropCnt(void);
+uint32_t DebugTx_GetBlockCnt(void);
+uint32_t DebugTx_GetMaxUsed(void);
+void DebugTx_ClearStats(void);
+void DebugTx_Flush(void);
+int32_t DebugTx_WriteRaw(const uint8_t *pu8Data, uint32_t u32Len);
+int32_t DebugTx_Pause(void (*pfnDrained)(void));
+void DebugTx_Resume(void);
+#endif
+
+/* main.c : SysTick interrupt count */
+unsigned long get_systick(void);
+
+/*
+ * core cycle from SysTick , free running (wrap after 2^32 cycle) , end - start is elapsed cycle
+ * one reload not yet counted by SysTick_Handler (interrupt masked) is included
+ * for benchmark / profile , SysTick_enable first
+ */
+unsigned long get_systick_cycle(void);
+
 void read_64_words(unsigned long start_addr , unsigned long* buffer);
 unsigned long _read_memory_u32 (const unsigned long addr_u32);
 unsigned short _read_memory_u16 (const unsigned long addr_u32);
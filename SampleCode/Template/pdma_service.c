@@ -0,0 +1,672 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "pdma_service.h"
+#include "pdma_sg.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _pdma_service_ch_t
+{
+    PDMA_SERVICE_REQ_T    *head;        /* running request */
+    PDMA_SERVICE_REQ_T    *tail;
+    PDMA_SERVICE_HOOK_T    hook;
+    void                  *user_data;
+    unsigned char          used;
+    unsigned char          reserved[3];
+
+} PDMA_SERVICE_CH_T;
+
+typedef struct _pdma_service_t
+{
+    PDMA_SERVICE_CH_T      ch[PDMA_SERVICE_CH_NUM];
+    PDMA_SERVICE_REQ_T    *donehead;    /* wait for callback */
+    PDMA_SERVICE_REQ_T    *donetail;
+    unsigned char          posted;
+    unsigned char          pollrun;
+    unsigned char          reserved[2];
+    unsigned long          abortcnt;
+    unsigned long          timeoutcnt;
+
+} PDMA_SERVICE_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile PDMA_SERVICE_T g_PdmaService;
+static int g_PdmaServiceTimerId = -1;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define PDMA_SERVICE_ENTER_CRITICAL(m)          do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define PDMA_SERVICE_EXIT_CRITICAL(m)           __set_PRIMASK(m)
+
+/* PDMA request timeout count peripheral request only , software trigger use deadline */
+#define PDMA_SERVICE_IS_HW_TIMEOUT(ch, req)     (((ch) < PDMA_SERVICE_HW_TIMEOUT_CH_NUM) && ((req)->periph != PDMA_MEM))
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long PdmaService_GetAbortCnt(void)
+{
+    return g_PdmaService.abortcnt;
+}
+
+unsigned long PdmaService_GetTimeoutCnt(void)
+{
+    return g_PdmaService.timeoutcnt;
+}
+
+unsigned long PdmaService_GetChannelMask(void)
+{
+    unsigned long mask;
+    unsigned char i;
+
+    mask = 0UL;
+
+    for (i = 0U; i < PDMA_SERVICE_CH_NUM; i++)
+    {
+        if (g_PdmaService.ch[i].used)
+        {
+            mask |= (1UL << i);
+        }
+    }
+
+    return mask;
+}
+
+int PdmaService_IsBusy(const PDMA_SERVICE_REQ_T *req)
+{
+    return (req->state != PDMA_SERVICE_REQ_IDLE) ? 1 : 0;
+}
+
+/* ms to PDMA timeout clock , 16 bit */
+unsigned long PdmaService_TimeoutCnt(unsigned short timeout_ms)
+{
+    unsigned long cnt;
+
+    cnt = ((SystemCoreClock >> (8U + PDMA_SERVICE_TOUT_PSC)) * timeout_ms) / 1000UL;
+
+    if (cnt == 0UL)
+    {
+        cnt = 1UL;
+    }
+    else if (cnt > 0xFFFFUL)
+    {
+        cnt = 0xFFFFUL;
+    }
+
+    return cnt;
+}
+
+/* unit left in current table , 0 if channel finished */
+static unsigned long PdmaService_Remain(unsigned char ch)
+{
+    unsigned long ctl;
+
+    ctl = PDMA->DSCT[ch].CTL;
+
+    if ((ctl & PDMA_DSCT_CTL_OPMODE_Msk) == 0UL)
+    {
+        return 0UL;
+    }
+
+    return ((ctl & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) + 1UL;
+}
+
+/* ISR or critical section */
+static void PdmaService_StartReq(unsigned char ch, PDMA_SERVICE_REQ_T *req)
+{
+    req->state = PDMA_SERVICE_REQ_RUN;
+    req->start = TimerService_GetTick();
+
+    PDMA->CHCTL |= (1UL << ch);
+
+    if (req->desc != (DSCT_T *)0)
+    {
+        /* first descriptor loaded by PDMA from chain */
+        PDMA->DSCT[ch].CTL = 0UL;
+        PDMA_SetTransferMode(PDMA, ch, req->periph, TRUE, (uint32_t)req->desc);
+    }
+    else
+    {
+        PDMA->DSCT[ch].SA  = req->src;
+        PDMA->DSCT[ch].DA  = req->dst;
+        PDMA->DSCT[ch].CTL = ((req->count - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) |
+                             (req->ctl & ~(PDMA_DSCT_CTL_TXCNT_Msk | PDMA_DSCT_CTL_OPMODE_Msk));
+        PDMA_SetTransferMode(PDMA, ch, req->periph, FALSE, 0);
+    }
+
+    if (PDMA_SERVICE_IS_HW_TIMEOUT(ch, req) && (req->timeout_ms != 0U))
+    {
+        PDMA_SetTimeOut(PDMA, ch, TRUE, PdmaService_TimeoutCnt(req->timeout_ms));
+        PDMA_EnableInt(PDMA, ch, PDMA_INT_TIMEOUT);
+    }
+
+    PDMA_EnableInt(PDMA, ch, PDMA_INT_TRANS_DONE);
+
+    if (req->periph == PDMA_MEM)
+    {
+        PDMA_Trigger(PDMA, ch);
+    }
+}
+
+void PdmaService_Process(void *user_data);
+
+/* ISR or critical section : req off channel queue , to done list */
+static void PdmaService_Retire(PDMA_SERVICE_REQ_T *req, signed char status)
+{
+    volatile PDMA_SERVICE_T *s;
+    s = &g_PdmaService;
+
+    req->status = status;
+    req->state  = PDMA_SERVICE_REQ_DONE;
+    req->next   = (PDMA_SERVICE_REQ_T *)0;
+
+    if (s->donetail == (PDMA_SERVICE_REQ_T *)0)
+    {
+        s->donehead = req;
+    }
+    else
+    {
+        s->donetail->next = req;
+    }
+    s->donetail = req;
+
+    /* post fail : PdmaService_Poll deliver */
+    if (s->posted == 0U)
+    {
+        if (TimerService_Post(PdmaService_Process, (void *)0) == 0)
+        {
+            s->posted = 1U;
+        }
+    }
+}
+
+/* ISR or critical section : idle channel must not time out */
+static void PdmaService_ParkTimeout(unsigned char ch)
+{
+    if (ch < PDMA_SERVICE_HW_TIMEOUT_CH_NUM)
+    {
+        PDMA_SetTimeOut(PDMA, ch, FALSE, 0);
+        PDMA_DisableInt(PDMA, ch, PDMA_INT_TIMEOUT);
+        PDMA_CLR_TMOUT_FLAG(PDMA, ch);
+    }
+}
+
+/* ISR or critical section */
+static void PdmaService_StopChannel(unsigned char ch)
+{
+    PDMA_STOP(PDMA, ch);
+    PDMA_CLR_TD_FLAG(PDMA, 1UL << ch);
+    PdmaService_ParkTimeout(ch);
+}
+
+/* ISR or critical section : running request complete , start next */
+static void PdmaService_Finish(unsigned char ch, signed char status)
+{
+    volatile PDMA_SERVICE_CH_T *c;
+    PDMA_SERVICE_REQ_T *req;
+
+    c = &g_PdmaService.ch[ch];
+
+    req = c->head;
+    if ((req == (PDMA_SERVICE_REQ_T *)0) || (req->state != PDMA_SERVICE_REQ_RUN))
+    {
+        return;
+    }
+
+    req->remain = (status == PDMA_SERVICE_OK) ? 0UL : PdmaService_Remain(ch);
+
+    if (status != PDMA_SERVICE_OK)
+    {
+        PdmaService_StopChannel(ch);
+    }
+    else
+    {
+        PdmaService_ParkTimeout(ch);
+    }
+
+    c->head = req->next;
+    if (c->head == (PDMA_SERVICE_REQ_T *)0)
+    {
+        c->tail = (PDMA_SERVICE_REQ_T *)0;
+    }
+
+    PdmaService_Retire(req, status);
+
+    if (c->head != (PDMA_SERVICE_REQ_T *)0)
+    {
+        PdmaService_StartReq(ch, c->head);
+    }
+}
+
+/* deferred completion , run in TimerService_Dispatch */
+void PdmaService_Process(void *user_data)
+{
+    volatile PDMA_SERVICE_T *s;
+    PDMA_SERVICE_REQ_T *req;
+    PDMA_SERVICE_CALLBACK_T cb;
+    void *user;
+    unsigned long count;
+    int status;
+    uint32_t primask;
+
+    (void)user_data;
+
+    s = &g_PdmaService;
+    s->posted = 0U;
+
+    for (;;)
+    {
+        PDMA_SERVICE_ENTER_CRITICAL(primask);
+        req = s->donehead;
+        if (req != (PDMA_SERVICE_REQ_T *)0)
+        {
+            s->donehead = req->next;
+            if (s->donehead == (PDMA_SERVICE_REQ_T *)0)
+            {
+                s->donetail = (PDMA_SERVICE_REQ_T *)0;
+            }
+        }
+        PDMA_SERVICE_EXIT_CRITICAL(primask);
+
+        if (req == (PDMA_SERVICE_REQ_T *)0)
+        {
+            return;
+        }
+
+        cb     = req->callback;
+        user   = req->user_data;
+        count  = req->count - req->remain;
+        status = req->status;
+
+        /* idle before callback : callback may submit again */
+        req->state = PDMA_SERVICE_REQ_IDLE;
+
+        if (cb != (PDMA_SERVICE_CALLBACK_T)0)
+        {
+            cb(status, count, user);
+        }
+    }
+}
+
+/* software deadline , deliver unposted callback , stop when nothing left */
+static void PdmaService_Poll(void *user_data)
+{
+    volatile PDMA_SERVICE_T *s;
+    PDMA_SERVICE_REQ_T *req;
+    unsigned long now;
+    unsigned char active;
+    unsigned char ch;
+    uint32_t primask;
+
+    (void)user_data;
+
+    s      = &g_PdmaService;
+    now    = TimerService_GetTick();
+    active = 0U;
+
+    for (ch = 0U; ch < PDMA_SERVICE_CH_NUM; ch++)
+    {
+        PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+        req = s->ch[ch].head;
+        if ((req != (PDMA_SERVICE_REQ_T *)0) &&
+            (req->state == PDMA_SERVICE_REQ_RUN) &&
+            (req->timeout_ms != 0U) &&
+            !PDMA_SERVICE_IS_HW_TIMEOUT(ch, req) &&
+            ((now - req->start) >= req->timeout_ms))
+        {
+            s->timeoutcnt++;
+            PdmaService_Finish(ch, PDMA_SERVICE_TIMEOUT);
+        }
+
+        PDMA_SERVICE_EXIT_CRITICAL(primask);
+    }
+
+    if ((s->donehead != (PDMA_SERVICE_REQ_T *)0) && (s->posted == 0U))
+    {
+        PdmaService_Process((void *)0);
+    }
+
+    /* check and stop together : submit from ISR restart timer */
+    PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+    for (ch = 0U; ch < PDMA_SERVICE_CH_NUM; ch++)
+    {
+        if (s->ch[ch].head != (PDMA_SERVICE_REQ_T *)0)
+        {
+            active = 1U;
+        }
+    }
+
+    if ((active == 0U) && (s->donehead == (PDMA_SERVICE_REQ_T *)0) && (g_PdmaServiceTimerId >= 0))
+    {
+        TimerService_StopTimer((unsigned int)g_PdmaServiceTimerId);
+        s->pollrun = 0U;
+    }
+
+    PDMA_SERVICE_EXIT_CRITICAL(primask);
+}
+
+/*
+ * queue mode retire a request on its first done interrupt , so only the last descriptor may raise one
+ * reject PDMA_SG_INT_EACH chain and ring (PdmaSg_MakeRing) , they belong to hook mode
+ * return 1 if chain end in basic mode with no done interrupt before
+ */
+static int PdmaService_ChainOk(const DSCT_T *d)
+{
+    unsigned int n;
+
+    for (n = 0U; n < 256U; n++)     /* PdmaSg pool hold 255 descriptor at most */
+    {
+        if ((d->CTL & PDMA_DSCT_CTL_OPMODE_Msk) != PDMA_OP_SCATTER)
+        {
+            return 1;
+        }
+
+        if ((d->CTL & PDMA_DSCT_CTL_TBINTDIS_Msk) == PDMA_TBINTDIS_ENABLE)
+        {
+            return 0;
+        }
+
+        d = (const DSCT_T *)(PDMA_SG_SCATBA + (d->NEXT & 0xFFFFUL));
+    }
+
+    return 0;
+}
+
+int PdmaService_Submit(unsigned char ch, PDMA_SERVICE_REQ_T *req)
+{
+    volatile PDMA_SERVICE_T *s;
+    volatile PDMA_SERVICE_CH_T *c;
+    uint32_t primask;
+
+    if ((ch >= PDMA_SERVICE_CH_NUM) || (req == (PDMA_SERVICE_REQ_T *)0) || (req->count == 0UL) ||
+        ((req->desc == (DSCT_T *)0) && (req->count > 65536UL)) ||
+        ((req->desc != (DSCT_T *)0) && (PdmaService_ChainOk(req->desc) == 0)))
+    {
+        return -1;
+    }
+
+    s = &g_PdmaService;
+    c = &s->ch[ch];
+
+    PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+    if ((c->used == 0U) || (c->hook != (PDMA_SERVICE_HOOK_T)0) ||
+        (req->state != PDMA_SERVICE_REQ_IDLE))
+    {
+        PDMA_SERVICE_EXIT_CRITICAL(primask);
+        return -1;
+    }
+
+    req->next   = (PDMA_SERVICE_REQ_T *)0;
+    req->status = PDMA_SERVICE_OK;
+    req->remain = req->count;
+    req->state  = PDMA_SERVICE_REQ_QUEUED;
+
+    if (c->tail == (PDMA_SERVICE_REQ_T *)0)
+    {
+        c->head = req;
+        c->tail = req;
+        PdmaService_StartReq(ch, req);
+    }
+    else
+    {
+        c->tail->next = req;
+        c->tail = req;
+    }
+
+    if ((s->pollrun == 0U) && (g_PdmaServiceTimerId >= 0))
+    {
+        s->pollrun = 1U;
+        TimerService_StartTimer((unsigned int)g_PdmaServiceTimerId);
+    }
+
+    PDMA_SERVICE_EXIT_CRITICAL(primask);
+
+    return 0;
+}
+
+int PdmaService_Cancel(PDMA_SERVICE_REQ_T *req)
+{
+    volatile PDMA_SERVICE_CH_T *c;
+    PDMA_SERVICE_REQ_T *prev;
+    PDMA_SERVICE_REQ_T *p;
+    unsigned char ch;
+    uint32_t primask;
+
+    PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+    for (ch = 0U; ch < PDMA_SERVICE_CH_NUM; ch++)
+    {
+        c = &g_PdmaService.ch[ch];
+
+        if (c->head == req)
+        {
+            PdmaService_Finish(ch, PDMA_SERVICE_CANCEL);
+            PDMA_SERVICE_EXIT_CRITICAL(primask);
+            return 0;
+        }
+
+        prev = c->head;
+        p    = (prev != (PDMA_SERVICE_REQ_T *)0) ? prev->next : (PDMA_SERVICE_REQ_T *)0;
+
+        while (p != (PDMA_SERVICE_REQ_T *)0)
+        {
+            if (p == req)
+            {
+                prev->next = p->next;
+                if (c->tail == p)
+                {
+                    c->tail = prev;
+                }
+
+                /* never started */
+                PdmaService_Retire(p, PDMA_SERVICE_CANCEL);
+                PDMA_SERVICE_EXIT_CRITICAL(primask);
+                return 0;
+            }
+
+            prev = p;
+            p    = p->next;
+        }
+    }
+
+    PDMA_SERVICE_EXIT_CRITICAL(primask);
+
+    return -1;
+}
+
+int PdmaService_AllocChannel(unsigned char flags, PDMA_SERVICE_HOOK_T hook, void *user_data)
+{
+    volatile PDMA_SERVICE_CH_T *c;
+    unsigned char first;
+    unsigned char i;
+    unsigned char ch;
+    uint32_t primask;
+
+    /* timeout channel last , unless asked for */
+    first = (flags & PDMA_SERVICE_ALLOC_HW_TIMEOUT) ? 0U : PDMA_SERVICE_HW_TIMEOUT_CH_NUM;
+
+    PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+    for (i = 0U; i < PDMA_SERVICE_CH_NUM; i++)
+    {
+        ch = (unsigned char)((first + i) % PDMA_SERVICE_CH_NUM);
+
+        if ((flags & PDMA_SERVICE_ALLOC_HW_TIMEOUT) && (ch >= PDMA_SERVICE_HW_TIMEOUT_CH_NUM))
+        {
+            break;
+        }
+
+        c = &g_PdmaService.ch[ch];
+        if (c->used == 0U)
+        {
+            c->used      = 1U;
+            c->hook      = hook;
+            c->user_data = user_data;
+            c->head      = (PDMA_SERVICE_REQ_T *)0;
+            c->tail      = (PDMA_SERVICE_REQ_T *)0;
+
+            PDMA_SERVICE_EXIT_CRITICAL(primask);
+            return (int)ch;
+        }
+    }
+
+    PDMA_SERVICE_EXIT_CRITICAL(primask);
+
+    return -1;
+}
+
+void PdmaService_FreeChannel(unsigned char ch)
+{
+    volatile PDMA_SERVICE_CH_T *c;
+    PDMA_SERVICE_REQ_T *req;
+    uint32_t primask;
+
+    if (ch >= PDMA_SERVICE_CH_NUM)
+    {
+        return;
+    }
+
+    c = &g_PdmaService.ch[ch];
+
+    PDMA_SERVICE_ENTER_CRITICAL(primask);
+
+    PdmaService_StopChannel(ch);
+    PDMA_DisableInt(PDMA, ch, PDMA_INT_TRANS_DONE);
+
+    /* left over request complete with cancel */
+    while (c->head != (PDMA_SERVICE_REQ_T *)0)
+    {
+        req = c->head;
+        c->head = req->next;
+        req->remain = req->count;
+        PdmaService_Retire(req, PDMA_SERVICE_CANCEL);
+    }
+
+    c->tail = (PDMA_SERVICE_REQ_T *)0;
+    c->hook = (PDMA_SERVICE_HOOK_T)0;
+    c->used = 0U;
+
+    PDMA_SERVICE_EXIT_CRITICAL(primask);
+}
+
+void PdmaService_IRQHandler(void)
+{
+    volatile PDMA_SERVICE_T *s;
+    volatile PDMA_SERVICE_CH_T *c;
+    unsigned long status;
+    unsigned long abort;
+    unsigned long done;
+    unsigned long tout;
+    unsigned char event;
+    unsigned char ch;
+
+    s = &g_PdmaService;
+
+    status = PDMA_GET_INT_STATUS(PDMA);
+    abort  = 0UL;
+    done   = 0UL;
+
+    if (status & PDMA_INTSTS_ABTIF_Msk)
+    {
+        abort = PDMA_GET_ABORT_STS(PDMA);
+        PDMA_CLR_ABORT_FLAG(PDMA, abort);
+    }
+
+    if (status & PDMA_INTSTS_TDIF_Msk)
+    {
+        /* channel with done interrupt only , other may be polled */
+        done = PDMA_GET_TD_STS(PDMA) & PDMA->INTEN;
+        PDMA_CLR_TD_FLAG(PDMA, done);
+    }
+
+    tout = (status & (PDMA_INTSTS_REQTOF0_Msk | PDMA_INTSTS_REQTOF1_Msk)) >> PDMA_INTSTS_REQTOF0_Pos;
+    if (tout != 0UL)
+    {
+        PDMA->INTSTS = tout << PDMA_INTSTS_REQTOF0_Pos;
+    }
+
+    for (ch = 0U; ch < PDMA_SERVICE_CH_NUM; ch++)
+    {
+        event = 0U;
+
+        if (done & (1UL << ch))
+        {
+            event |= PDMA_SERVICE_EVT_DONE;
+        }
+
+        if (abort & (1UL << ch))
+        {
+            event |= PDMA_SERVICE_EVT_ABORT;
+        }
+
+        if (tout & (1UL << ch))
+        {
+            event |= PDMA_SERVICE_EVT_TIMEOUT;
+        }
+
+        if (event == 0U)
+        {
+            continue;
+        }
+
+        c = &s->ch[ch];
+
+        if (c->hook != (PDMA_SERVICE_HOOK_T)0)
+        {
+            c->hook(ch, event, c->user_data);
+        }
+        else if (event & PDMA_SERVICE_EVT_ABORT)
+        {
+            s->abortcnt++;
+            PdmaService_Finish(ch, PDMA_SERVICE_ABORT);
+        }
+        else if (event & PDMA_SERVICE_EVT_DONE)
+        {
+            PdmaService_Finish(ch, PDMA_SERVICE_OK);
+        }
+        else
+        {
+            s->timeoutcnt++;
+            PdmaService_Finish(ch, PDMA_SERVICE_TIMEOUT);
+        }
+    }
+}
+
+void PdmaService_Init(void)
+{
+    volatile PDMA_SERVICE_T *s;
+    unsigned char i;
+
+    s = &g_PdmaService;
+
+    for (i = 0U; i < PDMA_SERVICE_CH_NUM; i++)
+    {
+        s->ch[i].head      = (PDMA_SERVICE_REQ_T *)0;
+        s->ch[i].tail      = (PDMA_SERVICE_REQ_T *)0;
+        s->ch[i].hook      = (PDMA_SERVICE_HOOK_T)0;
+        s->ch[i].user_data = (void *)0;
+        s->ch[i].used      = 0U;
+    }
+
+    s->donehead   = (PDMA_SERVICE_REQ_T *)0;
+    s->donetail   = (PDMA_SERVICE_REQ_T *)0;
+    s->posted     = 0U;
+    s->pollrun    = 0U;
+    s->abortcnt   = 0UL;
+    s->timeoutcnt = 0UL;
+
+    PdmaSg_SetBase();
+
+    PDMA->TOUTPSC = (PDMA_SERVICE_TOUT_PSC << PDMA_TOUTPSC_TOUTPSC0_Pos) |
+                    (PDMA_SERVICE_TOUT_PSC << PDMA_TOUTPSC_TOUTPSC1_Pos);
+
+    /* created stopped , run only while a request is pending */
+    g_PdmaServiceTimerId = TimerService_CreateTimerQueue(PDMA_SERVICE_POLL_MS, PdmaService_Poll, (void *)0);
+
+    NVIC_EnableIRQ(PDMA_IRQn);
+}
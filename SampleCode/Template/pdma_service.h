@@ -0,0 +1,121 @@
+#ifndef __PDMA_SERVICE_H__
+#define __PDMA_SERVICE_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * PDMA channel allocator and transfer queue
+ *
+ * queue mode : PdmaService_Submit() request , one running per channel , next start from PDMA IRQ ,
+ *              callback(status, count, user_data) run in TimerService_Dispatch
+ * hook mode  : driver program the channel itself (circular , streaming) , hook(ch, event) run in PDMA IRQ
+ *
+ * scatter-gather : req->desc from PdmaSg_Head() , remain at timeout / cancel is of current descriptor only
+ *                  queue mode take PDMA_SG_INT_LAST chain only , INT_EACH chain and ring need hook mode
+ *
+ * timeout : channel 0 / 1 use PDMA request timeout (PDMA_SetTimeOut , max idle time between peripheral request)
+ *           other channel use PDMA_SERVICE_POLL_MS software deadline from start of transfer
+ */
+#define PDMA_SERVICE_CH_NUM                     (PDMA_CH_MAX)
+#define PDMA_SERVICE_HW_TIMEOUT_CH_NUM          (2U)      /* channel 0 , 1 */
+#define PDMA_SERVICE_TOUT_PSC                   (7U)      /* timeout clock HCLK / 2^15 */
+#define PDMA_SERVICE_POLL_MS                    (10U)
+
+/* PdmaService_AllocChannel flag */
+#define PDMA_SERVICE_ALLOC_ANY                  (0x00U)   /* channel 2 .. 8 first , keep 0 / 1 for timeout user */
+#define PDMA_SERVICE_ALLOC_HW_TIMEOUT           (0x01U)   /* channel 0 / 1 only */
+
+/* hook event */
+#define PDMA_SERVICE_EVT_DONE                   (0x01U)
+#define PDMA_SERVICE_EVT_ABORT                  (0x02U)
+#define PDMA_SERVICE_EVT_TIMEOUT                (0x04U)
+
+/* request state */
+#define PDMA_SERVICE_REQ_IDLE                   (0U)      /* owned by caller */
+#define PDMA_SERVICE_REQ_QUEUED                 (1U)
+#define PDMA_SERVICE_REQ_RUN                    (2U)
+#define PDMA_SERVICE_REQ_DONE                   (3U)      /* wait for callback */
+
+/* completion status */
+#define PDMA_SERVICE_OK                         (0)
+#define PDMA_SERVICE_TIMEOUT                    (-1)
+#define PDMA_SERVICE_ABORT                      (-2)      /* bus error , channel disabled by PDMA */
+#define PDMA_SERVICE_CANCEL                     (-3)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* run in TimerService_Dispatch , never in ISR , count is transfer unit done */
+typedef void (*PDMA_SERVICE_CALLBACK_T)(int status, unsigned long count, void *user_data);
+
+/* run in PDMA_IRQHandler , event is PDMA_SERVICE_EVT_x mask , flag already cleared */
+typedef void (*PDMA_SERVICE_HOOK_T)(unsigned char ch, unsigned char event, void *user_data);
+
+/* caller owned , linked into channel queue without copy , must stay valid until callback */
+typedef struct _pdma_service_req_t
+{
+    struct _pdma_service_req_t *next;
+    unsigned long               src;
+    unsigned long               dst;
+    unsigned long               count;      /* transfer unit , 1 .. 65536 , chain total if desc */
+    unsigned long               ctl;        /* PDMA_WIDTH_x | PDMA_SAR_x | PDMA_DAR_x | PDMA_REQ_x | PDMA_BURST_x */
+    DSCT_T                     *desc;       /* scatter-gather chain (pdma_sg.h) , 0 : src / dst / ctl used */
+    unsigned char               periph;     /* PDMA_MEM (software trigger) or request source */
+    unsigned char               reserved;
+    unsigned short              timeout_ms; /* 0 : wait forever */
+    unsigned long               start;      /* TimerService_GetTick when channel start */
+    unsigned long               remain;     /* unit not transferred at completion */
+    PDMA_SERVICE_CALLBACK_T     callback;
+    void                       *user_data;
+    volatile unsigned char      state;
+    volatile signed char        status;
+
+} PDMA_SERVICE_REQ_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* PDMA clock must be enabled in SYS_Init , call after TimerService_Init */
+void PdmaService_Init(void);
+
+/*
+ * hook 0 : queue mode , else hook mode
+ * return channel , -1 if none left
+ */
+int  PdmaService_AllocChannel(unsigned char flags, PDMA_SERVICE_HOOK_T hook, void *user_data);
+
+/* queue must be empty , channel is stopped */
+void PdmaService_FreeChannel(unsigned char ch);
+
+/*
+ * ISR safe , start now if channel idle
+ * peripheral side PDMA enable (ex. UART_INTEN_TXPDMAEN) is set by caller
+ * return 0  : queued
+ *        -1 : channel not in queue mode , req busy , invalid count ,
+ *             desc chain with done interrupt before its end (PDMA_SG_INT_EACH , ring)
+ */
+int  PdmaService_Submit(unsigned char ch, PDMA_SERVICE_REQ_T *req);
+
+/* queued or running req complete with PDMA_SERVICE_CANCEL , return -1 if not pending */
+int  PdmaService_Cancel(PDMA_SERVICE_REQ_T *req);
+
+int  PdmaService_IsBusy(const PDMA_SERVICE_REQ_T *req);
+
+/* hook mode on channel 0 / 1 : PDMA_SetTimeOut count of timeout_ms , 1 .. 0xFFFF */
+unsigned long PdmaService_TimeoutCnt(unsigned short timeout_ms);
+
+/* bit n : channel n allocated */
+unsigned long PdmaService_GetChannelMask(void);
+unsigned long PdmaService_GetAbortCnt(void);
+unsigned long PdmaService_GetTimeoutCnt(void);
+
+/* call from PDMA_IRQHandler */
+void PdmaService_IRQHandler(void);
+
+#endif //__PDMA_SERVICE_H__
@@ -0,0 +1,187 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "pdma_sg.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define PDMA_SG_WINDOW                          (0x10000UL)
+
+/* field taken from caller ctl , rest belong to chain builder */
+#define PDMA_SG_CTL_USER_Msk                    (PDMA_DSCT_CTL_TXTYPE_Msk | PDMA_DSCT_CTL_BURSIZE_Msk | \
+                                                 PDMA_DSCT_CTL_SAINC_Msk | PDMA_DSCT_CTL_DAINC_Msk | \
+                                                 PDMA_DSCT_CTL_TXWIDTH_Msk)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define PDMA_SG_OFFSET(d)                       ((uint32_t)(d) - PDMA_SG_SCATBA)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+void PdmaSg_SetBase(void)
+{
+    PDMA->SCATBA = PDMA_SG_SCATBA;
+}
+
+/* return transfer count , or PDMA_SG_ERR_x */
+static long PdmaSg_Check(unsigned long src, unsigned long dst, unsigned long len, unsigned long ctl)
+{
+    unsigned long width;
+    unsigned long mask;
+
+    width = (ctl & PDMA_DSCT_CTL_TXWIDTH_Msk) >> PDMA_DSCT_CTL_TXWIDTH_Pos;
+    if ((width > 2UL) || (len == 0UL))
+    {
+        return PDMA_SG_ERR_PARAM;
+    }
+
+    /* byte / half word / word : fixed peripheral address must align too */
+    mask = (1UL << width) - 1UL;
+    if (((src | dst | len) & mask) != 0UL)
+    {
+        return PDMA_SG_ERR_ALIGN;
+    }
+
+    len >>= width;
+    if (len > 65536UL)
+    {
+        return PDMA_SG_ERR_COUNT;
+    }
+
+    return (long)len;
+}
+
+int PdmaSg_Init(PDMA_SG_CHAIN_T *chain, DSCT_T *pool, unsigned char size, unsigned char intmode)
+{
+    unsigned long off;
+
+    if ((chain == (PDMA_SG_CHAIN_T *)0) || (pool == (DSCT_T *)0) || (size == 0U))
+    {
+        return PDMA_SG_ERR_PARAM;
+    }
+
+    off = PDMA_SG_OFFSET(pool);
+    if (((off & 3UL) != 0UL) ||
+        ((uint32_t)pool < PDMA_SG_SCATBA) ||
+        ((off + ((unsigned long)size * sizeof(DSCT_T))) > PDMA_SG_WINDOW))
+    {
+        return PDMA_SG_ERR_PARAM;
+    }
+
+    chain->pool    = pool;
+    chain->size    = size;
+    chain->intmode = intmode;
+    PdmaSg_Reset(chain);
+
+    return 0;
+}
+
+void PdmaSg_Reset(PDMA_SG_CHAIN_T *chain)
+{
+    chain->count = 0U;
+    chain->ring  = 0U;
+    chain->total = 0UL;
+}
+
+int PdmaSg_Add(PDMA_SG_CHAIN_T *chain, unsigned long src, unsigned long dst, unsigned long len, unsigned long ctl)
+{
+    DSCT_T *d;
+    DSCT_T *prev;
+    long cnt;
+
+    if (chain->ring)
+    {
+        return PDMA_SG_ERR_RING;
+    }
+
+    if (chain->count >= chain->size)
+    {
+        return PDMA_SG_ERR_FULL;
+    }
+
+    cnt = PdmaSg_Check(src, dst, len, ctl);
+    if (cnt < 0L)
+    {
+        return (int)cnt;
+    }
+
+    d = &chain->pool[chain->count];
+
+    /* new tail : basic mode end the chain , done interrupt always */
+    d->SA   = src;
+    d->DA   = dst;
+    d->NEXT = 0UL;
+    d->CTL  = (((unsigned long)cnt - 1UL) << PDMA_DSCT_CTL_TXCNT_Pos) |
+              (ctl & PDMA_SG_CTL_USER_Msk) | PDMA_TBINTDIS_ENABLE | PDMA_OP_BASIC;
+
+    /* old tail : link to new one */
+    if (chain->count != 0U)
+    {
+        prev = &chain->pool[chain->count - 1U];
+        prev->NEXT = PDMA_SG_OFFSET(d);
+        prev->CTL  = (prev->CTL & ~(PDMA_DSCT_CTL_OPMODE_Msk | PDMA_DSCT_CTL_TBINTDIS_Msk)) |
+                     ((chain->intmode == PDMA_SG_INT_EACH) ? PDMA_TBINTDIS_ENABLE : PDMA_TBINTDIS_DISABLE) |
+                     PDMA_OP_SCATTER;
+    }
+
+    chain->total += (unsigned long)cnt;
+
+    return (int)(chain->count++);
+}
+
+int PdmaSg_Build(PDMA_SG_CHAIN_T *chain, const PDMA_SG_SEG_T *seg, unsigned char n)
+{
+    unsigned char i;
+    long r;
+
+    if (chain->ring)
+    {
+        return PDMA_SG_ERR_RING;
+    }
+
+    if (((unsigned int)chain->count + n) > chain->size)
+    {
+        return PDMA_SG_ERR_FULL;
+    }
+
+    /* check all first , chain untouched on error */
+    for (i = 0U; i < n; i++)
+    {
+        r = PdmaSg_Check(seg[i].src, seg[i].dst, seg[i].len, seg[i].ctl);
+        if (r < 0L)
+        {
+            return (int)r;
+        }
+    }
+
+    for (i = 0U; i < n; i++)
+    {
+        (void)PdmaSg_Add(chain, seg[i].src, seg[i].dst, seg[i].len, seg[i].ctl);
+    }
+
+    return (int)chain->count;
+}
+
+int PdmaSg_MakeRing(PDMA_SG_CHAIN_T *chain)
+{
+    DSCT_T *last;
+
+    if (chain->count == 0U)
+    {
+        return PDMA_SG_ERR_PARAM;
+    }
+
+    last = &chain->pool[chain->count - 1U];
+
+    /* one interrupt per lap at least */
+    last->NEXT = PDMA_SG_OFFSET(&chain->pool[0]);
+    last->CTL  = (last->CTL & ~(PDMA_DSCT_CTL_OPMODE_Msk | PDMA_DSCT_CTL_TBINTDIS_Msk)) |
+                 PDMA_TBINTDIS_ENABLE | PDMA_OP_SCATTER;
+
+    chain->ring = 1U;
+
+    return 0;
+}
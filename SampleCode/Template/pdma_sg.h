@@ -0,0 +1,86 @@
+#ifndef __PDMA_SG_H__
+#define __PDMA_SG_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * scatter-gather descriptor chain in caller pool , PDMA walk the chain without CPU
+ *
+ *   static DSCT_T pool[3];
+ *   PdmaSg_Init(&chain, pool, 3U, PDMA_SG_INT_LAST);
+ *   PdmaSg_Add(&chain, (uint32_t)hdr,  (uint32_t)&UART0->DAT, 4U,   PDMA_WIDTH_8 | PDMA_SAR_INC | PDMA_DAR_FIX | PDMA_REQ_SINGLE);
+ *   PdmaSg_Add(&chain, (uint32_t)data, (uint32_t)&UART0->DAT, len,  PDMA_WIDTH_8 | PDMA_SAR_INC | PDMA_DAR_FIX | PDMA_REQ_SINGLE);
+ *   PdmaSg_Add(&chain, (uint32_t)crc,  (uint32_t)&UART0->DAT, 4U,   PDMA_WIDTH_8 | PDMA_SAR_INC | PDMA_DAR_FIX | PDMA_REQ_SINGLE);
+ *   req.desc = PdmaSg_Head(&chain);  req.count = PdmaSg_GetTotal(&chain);  PdmaService_Submit(ch, &req);
+ *
+ * chain is valid after every add : last descriptor is basic mode (end of transfer)
+ * descriptor must be in [PDMA_SG_SCATBA , PDMA_SG_SCATBA + 64 KB) , NEXT is 16 bit offset
+ */
+#define PDMA_SG_SCATBA                          (SRAM_BASE)
+
+/* PdmaSg_Init int_mode */
+#define PDMA_SG_INT_LAST                        (0U)      /* one done interrupt at end of chain */
+#define PDMA_SG_INT_EACH                        (1U)      /* done interrupt on every descriptor (ring , ping-pong) ,
+                                                             hook mode channel only , PdmaService_Submit reject it */
+
+/* error */
+#define PDMA_SG_ERR_PARAM                       (-1)      /* null , zero length , pool outside SCATBA window */
+#define PDMA_SG_ERR_FULL                        (-2)
+#define PDMA_SG_ERR_ALIGN                       (-3)      /* address or length not multiple of width */
+#define PDMA_SG_ERR_COUNT                       (-4)      /* more than 65536 transfer in one segment */
+#define PDMA_SG_ERR_RING                        (-5)      /* chain already closed as ring */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+typedef struct _pdma_sg_chain_t
+{
+    DSCT_T          *pool;
+    unsigned char    size;
+    unsigned char    count;
+    unsigned char    intmode;
+    unsigned char    ring;
+    unsigned long    total;         /* transfer unit of all segment */
+
+} PDMA_SG_CHAIN_T;
+
+/* one segment , len in byte */
+typedef struct _pdma_sg_seg_t
+{
+    unsigned long    src;
+    unsigned long    dst;
+    unsigned long    len;
+    unsigned long    ctl;           /* PDMA_WIDTH_x | PDMA_SAR_x | PDMA_DAR_x | PDMA_REQ_x | PDMA_BURST_x */
+
+} PDMA_SG_SEG_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define PdmaSg_Head(chain)                      (((chain)->count != 0U) ? &(chain)->pool[0] : (DSCT_T *)0)
+#define PdmaSg_GetTotal(chain)                  ((chain)->total)
+#define PdmaSg_GetCount(chain)                  ((chain)->count)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* return 0 , PDMA_SG_ERR_PARAM if pool not word aligned or outside SCATBA window */
+int  PdmaSg_Init(PDMA_SG_CHAIN_T *chain, DSCT_T *pool, unsigned char size, unsigned char intmode);
+
+/* empty chain , pool reused */
+void PdmaSg_Reset(PDMA_SG_CHAIN_T *chain);
+
+/* append one segment , return descriptor index or PDMA_SG_ERR_x */
+int  PdmaSg_Add(PDMA_SG_CHAIN_T *chain, unsigned long src, unsigned long dst, unsigned long len, unsigned long ctl);
+
+/* append n segment , all or nothing , return descriptor count or PDMA_SG_ERR_x */
+int  PdmaSg_Build(PDMA_SG_CHAIN_T *chain, const PDMA_SG_SEG_T *seg, unsigned char n);
+
+/* last descriptor link back to first , PDMA never stop (circular receive , ping-pong) */
+int  PdmaSg_MakeRing(PDMA_SG_CHAIN_T *chain);
+
+/* PDMA_SCATBA must point to descriptor window , done by PdmaService_Init */
+void PdmaSg_SetBase(void);
+
+#endif //__PDMA_SG_H__
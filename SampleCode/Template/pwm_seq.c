@@ -0,0 +1,301 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "pwm_seq.h"
+#include "pdma_service.h"
+#include "pdma_sg.h"
+
+#if defined (ENABLE_PWM_SEQ)
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _pwm_seq_t
+{
+    unsigned long            clk;           /* PWM counter clock , after prescaler */
+    unsigned long            period;        /* PERIOD + 1 */
+    unsigned long            passcnt;       /* written by PDMA IRQ */
+    PWM_SEQ_CALLBACK_T       callback;
+    void                    *user_data;
+    unsigned char            ch;            /* from PdmaService_AllocChannel */
+    unsigned char            flag;
+    unsigned char            posted;
+    unsigned char            running;
+
+} PWM_SEQ_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile PWM_SEQ_T g_PwmSeq;
+
+/* descriptor in SRAM , one segment , ring onto itself in PWM_SEQ_LOOP */
+static DSCT_T g_PwmSeqDesc[1];
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define PWM_SEQ_PERIOD_REG                      (PWM_SEQ_PORT->PERIOD[(PWM_SEQ_CH >> 1) << 1])
+#define PWM_SEQ_CMP_REG                         (PWM_SEQ_PORT->CMPDAT[PWM_SEQ_CH])
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long PwmSeq_GetPassCnt(void)
+{
+    return g_PwmSeq.passcnt;
+}
+
+unsigned long PwmSeq_GetPeriod(void)
+{
+    return g_PwmSeq.period;
+}
+
+int PwmSeq_IsRunning(void)
+{
+    return g_PwmSeq.running ? 1 : 0;
+}
+
+/* edge aligned down count : CMPDAT = PERIOD high almost whole period , CMPDAT 0 low but one PWM clock */
+unsigned long PwmSeq_DutyToCmp(unsigned short permille)
+{
+    unsigned long period;
+
+    period = g_PwmSeq.period;
+
+    if (permille >= 1000U)
+    {
+        return (period != 0UL) ? (period - 1UL) : 0UL;
+    }
+
+    return ((unsigned long)permille * period) / 1000UL;
+}
+
+unsigned long PwmSeq_HzToPeriod(unsigned long hz)
+{
+    unsigned long cnt;
+
+    if (hz == 0UL)
+    {
+        return 0UL;
+    }
+
+    cnt = g_PwmSeq.clk / hz;
+    if ((cnt < 2UL) || (cnt > 0x10000UL))
+    {
+        return 0UL;
+    }
+
+    return cnt - 1UL;
+}
+
+void PwmSeq_BuildRamp(unsigned long *table, unsigned int n, unsigned short from_permille, unsigned short to_permille,
+                      unsigned char curve)
+{
+    unsigned long duty;
+    long span;
+    unsigned int i;
+
+    if ((table == (unsigned long *)0) || (n == 0U))
+    {
+        return;
+    }
+
+    span = (long)to_permille - (long)from_permille;
+
+    for (i = 0U; i < n; i++)
+    {
+        duty = from_permille;
+        if (n > 1U)
+        {
+            duty = (unsigned long)((long)from_permille + ((span * (long)i) / (long)(n - 1U)));
+        }
+
+        if (curve == PWM_SEQ_RAMP_SQUARE)
+        {
+            duty = (duty * duty) / 1000UL;
+        }
+
+        table[i] = PwmSeq_DutyToCmp((unsigned short)duty);
+    }
+}
+
+int PwmSeq_SetDuty(unsigned short permille)
+{
+    if ((g_PwmSeq.period == 0UL) || g_PwmSeq.running)
+    {
+        return -1;
+    }
+
+    PWM_SEQ_CMP_REG = PwmSeq_DutyToCmp(permille);
+
+    return 0;
+}
+
+/* pass done , run in TimerService_Dispatch */
+static void PwmSeq_Process(void *user_data)
+{
+    volatile PWM_SEQ_T *s;
+
+    (void)user_data;
+
+    s = &g_PwmSeq;
+    s->posted = 0U;
+
+    if (s->callback != (PWM_SEQ_CALLBACK_T)0)
+    {
+        s->callback(s->passcnt, s->user_data);
+    }
+}
+
+/* PDMA IRQ , last step of table moved */
+static void PwmSeq_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    volatile PWM_SEQ_T *s;
+
+    (void)ch;
+    (void)user_data;
+
+    s = &g_PwmSeq;
+
+    if (event & PDMA_SERVICE_EVT_ABORT)
+    {
+        TIMER_Stop(PWM_SEQ_TIMER);
+        s->running = 0U;    /* channel disabled by PDMA , PwmSeq_Start again */
+        return;
+    }
+
+    if (event & PDMA_SERVICE_EVT_DONE)
+    {
+        s->passcnt++;
+
+        if ((s->flag & PWM_SEQ_LOOP) == 0U)
+        {
+            TIMER_Stop(PWM_SEQ_TIMER);
+            s->running = 0U;
+        }
+
+        if ((s->callback != (PWM_SEQ_CALLBACK_T)0) && (s->posted == 0U))
+        {
+            if (TimerService_Post(PwmSeq_Process, (void *)0) == 0)
+            {
+                s->posted = 1U;
+            }
+        }
+    }
+}
+
+void PwmSeq_Stop(void)
+{
+    volatile PWM_SEQ_T *s;
+    s = &g_PwmSeq;
+
+    if (s->ch == PWM_SEQ_CH_NONE)
+    {
+        return;
+    }
+
+    TIMER_Stop(PWM_SEQ_TIMER);
+
+    PDMA_DisableInt(PDMA, s->ch, PDMA_INT_TRANS_DONE);
+    PDMA_STOP(PDMA, s->ch);
+    PDMA_CLR_TD_FLAG(PDMA, 1UL << s->ch);
+
+    s->running = 0U;
+}
+
+int PwmSeq_Start(const unsigned long *table, unsigned long n, unsigned long step_hz, unsigned char flag)
+{
+    volatile PWM_SEQ_T *s;
+    PDMA_SG_CHAIN_T chain;
+    unsigned long dst;
+
+    s = &g_PwmSeq;
+
+    if ((s->ch == PWM_SEQ_CH_NONE) || (table == (const unsigned long *)0) ||
+        (n == 0UL) || (n > PWM_SEQ_MAX_STEP) ||
+        (step_hz == 0UL) || (step_hz > (s->clk / s->period)))
+    {
+        return -1;
+    }
+
+    PwmSeq_Stop();
+
+    dst = (flag & PWM_SEQ_TARGET_PERIOD) ? (unsigned long)&PWM_SEQ_PERIOD_REG : (unsigned long)&PWM_SEQ_CMP_REG;
+
+    (void)PdmaSg_Init(&chain, g_PwmSeqDesc, 1U, PDMA_SG_INT_EACH);
+    if (PdmaSg_Add(&chain, (unsigned long)table, dst, n * 4UL,
+                   PDMA_WIDTH_32 | PDMA_SAR_INC | PDMA_DAR_FIX | PDMA_REQ_SINGLE) != 0)
+    {
+        return -1;
+    }
+
+    if (flag & PWM_SEQ_LOOP)
+    {
+        (void)PdmaSg_MakeRing(&chain);
+    }
+
+    s->flag    = flag;
+    s->passcnt = 0UL;
+    s->running = 1U;
+
+    /* one word per TIMER3 request , start from first step */
+    PDMA->CHCTL |= (1UL << s->ch);
+    PDMA->DSCT[s->ch].CTL = 0UL;
+    PDMA_SetTransferMode(PDMA, s->ch, PDMA_TMR3, TRUE, (uint32_t)&g_PwmSeqDesc[0]);
+    PDMA_EnableInt(PDMA, s->ch, PDMA_INT_TRANS_DONE);
+
+    (void)TIMER_Open(PWM_SEQ_TIMER, TIMER_PERIODIC_MODE, step_hz);
+    TIMER_SetTriggerSource(PWM_SEQ_TIMER, TIMER_TRGSRC_TIMEOUT_EVENT);
+    TIMER_SetTriggerTarget(PWM_SEQ_TIMER, TIMER_TRG_TO_PDMA);
+    TIMER_Start(PWM_SEQ_TIMER);
+
+    return 0;
+}
+
+int PwmSeq_Init(unsigned long pwm_hz, PWM_SEQ_CALLBACK_T callback, void *user_data)
+{
+    volatile PWM_SEQ_T *s;
+    unsigned long src;
+    int ch;
+
+    s = &g_PwmSeq;
+
+    s->clk       = 0UL;
+    s->period    = 0UL;
+    s->passcnt   = 0UL;
+    s->callback  = callback;
+    s->user_data = user_data;
+    s->ch        = PWM_SEQ_CH_NONE;
+    s->flag      = 0U;
+    s->posted    = 0U;
+    s->running   = 0U;
+
+    /* same source selection as PWM_ConfigOutputChannel */
+    src = (CLK->CLKSEL2 & CLK_CLKSEL2_PWM0SEL_Msk) ? CLK_GetPCLK0Freq() : CLK_GetPLLClockFreq();
+    if ((pwm_hz == 0UL) || (src < (pwm_hz * 2UL)))
+    {
+        return -1;
+    }
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, PwmSeq_PdmaHook, (void *)0);
+    if (ch < 0)
+    {
+        return -1;
+    }
+
+    s->ch = (unsigned char)ch;
+
+    /* prescaler , period and edge aligned waveform once , sequence write CMPDAT / PERIOD only */
+    (void)PWM_ConfigOutputChannel(PWM_SEQ_PORT, PWM_SEQ_CH, pwm_hz, 50UL);
+
+    s->period = PWM_SEQ_PERIOD_REG + 1UL;
+    s->clk    = src / (PWM_SEQ_PORT->CLKPSC[PWM_SEQ_CH >> 1] + 1UL);
+
+    PWM_SEQ_CMP_REG = 0UL;
+
+    PWM_EnableOutput(PWM_SEQ_PORT, 1UL << PWM_SEQ_CH);
+    PWM_Start(PWM_SEQ_PORT, 1UL << PWM_SEQ_CH);
+
+    return 0;
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef __PWM_SEQ_H__
+#define __PWM_SEQ_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * PWM waveform sequencer , no CPU per step
+ *
+ * table   : precomputed register value , one 32 bit word per step (PwmSeq_DutyToCmp / PwmSeq_BuildRamp ,
+ *           or const table in flash) , all divide done once when the table is built
+ * step    : TIMER timeout event request PDMA , one word table -> CMPDAT (or PERIOD) per step
+ *           M031 PWM PDMA request is capture only , so the step clock is a TIMER , not the PWM period event
+ * glitch  : CMPDAT / PERIOD are buffered , new value load at PWM period end , step_hz <= PWM frequency
+ *           (faster step : some value never reach the output)
+ * mode    : PWM_SEQ_ONCE stop on last step , output keep last value , PWM_SEQ_LOOP one descriptor ring
+ *           done interrupt once per pass , callback(pass, user_data) run in TimerService_Dispatch
+ * target  : PWM_SEQ_TARGET_PERIOD stream PERIOD of the channel pair (tone sweep) , CMPDAT keep its value
+ *           PERIOD and CMPDAT are not adjacent , so one sequence drive one of them
+ */
+#define PWM_SEQ_PORT                            (PWM0)
+#define PWM_SEQ_CH                              (0U)      /* PB.5 PWM0_CH0 , pin set in SYS_Init */
+#define PWM_SEQ_TIMER                           (TIMER3)
+#define PWM_SEQ_MAX_STEP                        (65536UL) /* PDMA transfer count */
+
+#define PWM_SEQ_CH_NONE                         (0xFFU)
+
+/* PwmSeq_Start flag */
+#define PWM_SEQ_ONCE                            (0x00U)
+#define PWM_SEQ_LOOP                            (0x01U)
+#define PWM_SEQ_TARGET_CMP                      (0x00U)
+#define PWM_SEQ_TARGET_PERIOD                   (0x02U)
+
+/* PwmSeq_BuildRamp curve */
+#define PWM_SEQ_RAMP_LINEAR                     (0U)
+#define PWM_SEQ_RAMP_SQUARE                     (1U)      /* duty ^ 2 , LED fade look linear to the eye */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* pass : finished pass count (PWM_SEQ_ONCE : 1) */
+typedef void (*PWM_SEQ_CALLBACK_T)(unsigned long pass, void *user_data);
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * call after PdmaService_Init , PWM0 / TIMER3 clock enabled in SYS_Init
+ * pwm_hz : PWM frequency , prescaler and period computed once , output start at 0 duty
+ * return 0 , -1 if no PDMA channel or no PWM clock
+ */
+int  PwmSeq_Init(unsigned long pwm_hz, PWM_SEQ_CALLBACK_T callback, void *user_data);
+
+/* PWM clock per period (CMPDAT full scale) */
+unsigned long PwmSeq_GetPeriod(void);
+
+/* permille 0 .. 1000 to CMPDAT value */
+unsigned long PwmSeq_DutyToCmp(unsigned short permille);
+
+/* hz to PERIOD value at current prescaler , for PWM_SEQ_TARGET_PERIOD , 0 if out of range */
+unsigned long PwmSeq_HzToPeriod(unsigned long hz);
+
+/* n step from from_permille to to_permille (both included) , curve PWM_SEQ_RAMP_x */
+void PwmSeq_BuildRamp(unsigned long *table, unsigned int n, unsigned short from_permille, unsigned short to_permille,
+                      unsigned char curve);
+
+/* direct CMPDAT write , not while running */
+int  PwmSeq_SetDuty(unsigned short permille);
+
+/*
+ * table must stay valid while running , n 1 .. PWM_SEQ_MAX_STEP , flag PWM_SEQ_ONCE / LOOP | TARGET_x
+ * return 0 , -1 if not init , bad parameter or step_hz above PWM frequency
+ */
+int  PwmSeq_Start(const unsigned long *table, unsigned long n, unsigned long step_hz, unsigned char flag);
+
+/* stop on current step , output keep running at last value */
+void PwmSeq_Stop(void);
+
+int  PwmSeq_IsRunning(void);
+
+unsigned long PwmSeq_GetPassCnt(void);
+
+#endif //__PWM_SEQ_H__
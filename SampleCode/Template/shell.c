@@ -0,0 +1,236 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+#include "shell.h"
+#include "uart_rx.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define SHELL_READ_CHUNK                        (16U)
+
+typedef struct _shell_t
+{
+    const SHELL_CMD_T *cmds[SHELL_MAX_CMDS];
+    unsigned char      cmdcnt;
+    char               line[SHELL_LINE_SIZE];
+    unsigned char      len;
+    unsigned char      truncated;   /* line longer than SHELL_LINE_SIZE , drop on enter */
+    char               lastch;
+
+} SHELL_T;
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static SHELL_T g_Shell;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+static int Shell_CmdHelp(int argc, char *argv[])
+{
+    unsigned char i;
+
+    (void)argc;
+    (void)argv;
+
+    for (i = 0U; i < g_Shell.cmdcnt; i++)
+    {
+        printf("%-10s %s\r\n", g_Shell.cmds[i]->name,
+               (g_Shell.cmds[i]->help != (const char *)0) ? g_Shell.cmds[i]->help : "");
+    }
+
+    return 0;
+}
+
+static const SHELL_CMD_T s_ShellCmdHelp =
+{
+    "help", Shell_CmdHelp, "list command"
+};
+
+int Shell_Register(const SHELL_CMD_T *cmd)
+{
+    unsigned char i;
+
+    if ((cmd == (const SHELL_CMD_T *)0) ||
+        (cmd->name == (const char *)0) ||
+        (cmd->handler == (SHELL_HANDLER_T)0) ||
+        (g_Shell.cmdcnt >= SHELL_MAX_CMDS))
+    {
+        return -1;
+    }
+
+    for (i = 0U; i < g_Shell.cmdcnt; i++)
+    {
+        if (strcmp(g_Shell.cmds[i]->name, cmd->name) == 0)
+        {
+            return -1;
+        }
+    }
+
+    g_Shell.cmds[g_Shell.cmdcnt++] = cmd;
+
+    return 0;
+}
+
+int Shell_RegisterTable(const SHELL_CMD_T *tbl, unsigned int count)
+{
+    unsigned int i;
+    int n = 0;
+
+    for (i = 0U; i < count; i++)
+    {
+        if (Shell_Register(&tbl[i]) == 0)
+        {
+            n++;
+        }
+    }
+
+    return n;
+}
+
+int Shell_Execute(char *line)
+{
+    char *argv[SHELL_MAX_ARGS];
+    int argc = 0;
+    unsigned char i;
+    char *p = line;
+
+    while ((*p != '\0') && (argc < (int)SHELL_MAX_ARGS))
+    {
+        while (*p == ' ')
+        {
+            *p++ = '\0';
+        }
+
+        if (*p == '\0')
+        {
+            break;
+        }
+
+        argv[argc++] = p;
+
+        while ((*p != ' ') && (*p != '\0'))
+        {
+            p++;
+        }
+    }
+
+    if (argc == 0)
+    {
+        return 0;
+    }
+
+    for (i = 0U; i < g_Shell.cmdcnt; i++)
+    {
+        if (strcmp(g_Shell.cmds[i]->name, argv[0]) == 0)
+        {
+            return g_Shell.cmds[i]->handler(argc, argv);
+        }
+    }
+
+    printf("unknown command : %s\r\n", argv[0]);
+
+    return -1;
+}
+
+static void Shell_Input(char ch)
+{
+    SHELL_T *s;
+    s = &g_Shell;
+
+    if ((ch == '\r') || (ch == '\n'))
+    {
+        /* CR LF from terminal : one line end */
+        if ((ch == '\n') && (s->lastch == '\r'))
+        {
+            s->lastch = ch;
+            return;
+        }
+        s->lastch = ch;
+
+        #if (SHELL_ECHO == 1U)
+        printf("\r\n");
+        #endif
+
+        if (s->truncated)
+        {
+            printf("line too long\r\n");
+        }
+        else
+        {
+            s->line[s->len] = '\0';
+            (void)Shell_Execute(s->line);
+        }
+
+        s->len       = 0U;
+        s->truncated = 0U;
+        printf(SHELL_PROMPT);
+        return;
+    }
+
+    s->lastch = ch;
+
+    if ((ch == '\b') || (ch == 0x7F))
+    {
+        if (s->len > 0U)
+        {
+            s->len--;
+            #if (SHELL_ECHO == 1U)
+            printf("\b \b");
+            #endif
+        }
+        return;
+    }
+
+    if ((ch < ' ') || (ch > '~'))
+    {
+        return;
+    }
+
+    if (s->len >= (SHELL_LINE_SIZE - 1U))
+    {
+        s->truncated = 1U;
+        return;
+    }
+
+    s->line[s->len++] = ch;
+
+    #if (SHELL_ECHO == 1U)
+    putchar(ch);
+    #endif
+}
+
+void Shell_Process(void *user_data)
+{
+    unsigned char chunk[SHELL_READ_CHUNK];
+    unsigned int n;
+    unsigned int i;
+
+    (void)user_data;
+
+    /* rearm first : byte arrive while parsing will post again */
+    UartRx_Rearm();
+
+    while ((n = UartRx_Read(chunk, sizeof(chunk))) > 0U)
+    {
+        for (i = 0U; i < n; i++)
+        {
+            Shell_Input((char)chunk[i]);
+        }
+    }
+}
+
+void Shell_Init(void)
+{
+    g_Shell.cmdcnt    = 0U;
+    g_Shell.len       = 0U;
+    g_Shell.truncated = 0U;
+    g_Shell.lastch    = 0;
+
+    (void)Shell_Register(&s_ShellCmdHelp);
+
+    UartRx_Init(Shell_Process, (void *)0);
+}
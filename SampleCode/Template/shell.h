@@ -0,0 +1,52 @@
+#ifndef __SHELL_H__
+#define __SHELL_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/* help 1 + main.c 3 (+9 ENABLE_x) + timer_cli 5 + log 1 = 19 , keep spare */
+#define SHELL_MAX_CMDS                          (24U)
+#define SHELL_LINE_SIZE                         (64U)
+#define SHELL_MAX_ARGS                          (8U)
+#define SHELL_ECHO                              (1U)      /* 0 : terminal with local echo */
+#define SHELL_PROMPT                            "> "
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* argv[0] is command name , return value is not used by shell */
+typedef int (*SHELL_HANDLER_T)(int argc, char *argv[]);
+
+typedef struct _shell_cmd_t
+{
+    const char      *name;
+    SHELL_HANDLER_T  handler;
+    const char      *help;
+
+} SHELL_CMD_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* register "help" and hook UART RX ring , call after TimerService_Init */
+void Shell_Init(void);
+
+/*
+ * cmd must stay valid (static const table)
+ * return 0  : registered
+ *        -1 : table full , duplicate name or invalid cmd
+ */
+int  Shell_Register(const SHELL_CMD_T *cmd);
+
+/* register count entry, return number registered */
+int  Shell_RegisterTable(const SHELL_CMD_T *tbl, unsigned int count);
+
+/* UART RX consumer , posted by UartRx_IRQHandler and run in TimerService_Dispatch */
+void Shell_Process(void *user_data);
+
+/* run one line directly (no echo) , line is modified by tokenizer */
+int  Shell_Execute(char *line);
+
+#endif //__SHELL_H__
@@ -0,0 +1,369 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "telemetry.h"
+#include "crc_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+typedef struct _telemetry_cobs_t
+{
+    unsigned char *dst;
+    unsigned int   pos;
+    unsigned int   codepos;
+    unsigned char  code;
+
+} TELEMETRY_COBS_T;
+
+typedef struct _telemetry_t
+{
+    TELEMETRY_PKT_T   *head;
+    TELEMETRY_PKT_T   *tail;
+    TELEMETRY_SINK_T   sink;
+    unsigned char      frame[TELEMETRY_FRAME_MAX];
+    unsigned short     flen;
+    unsigned short     foff;        /* frame byte already in sink */
+    unsigned char      seq;
+    unsigned char      posted;
+    unsigned char      retry;       /* retry timer running */
+    unsigned long      framecnt;
+    unsigned long      bytecnt;
+    unsigned long      stallcnt;    /* sink full or CRC busy , retry after TELEMETRY_RETRY_MS */
+
+} TELEMETRY_T;
+
+extern void SendChar_ToUART(int ch);
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+static volatile TELEMETRY_T g_Telemetry;
+static CRC_SERVICE_CTX_T s_TelemetryCrc;
+static int g_TelemetryTimerId = -1;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define TELEMETRY_ENTER_CRITICAL(m)             do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define TELEMETRY_EXIT_CRITICAL(m)              __set_PRIMASK(m)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long Telemetry_GetFrameCnt(void)
+{
+    return g_Telemetry.framecnt;
+}
+
+unsigned long Telemetry_GetByteCnt(void)
+{
+    return g_Telemetry.bytecnt;
+}
+
+unsigned long Telemetry_GetStallCnt(void)
+{
+    return g_Telemetry.stallcnt;
+}
+
+static void Telemetry_CobsBegin(TELEMETRY_COBS_T *c, unsigned char *dst)
+{
+    c->dst     = dst;
+    c->codepos = 0U;
+    c->pos     = 1U;
+    c->code    = 1U;
+}
+
+static void Telemetry_CobsPut(TELEMETRY_COBS_T *c, unsigned char b)
+{
+    if (b == 0U)
+    {
+        c->dst[c->codepos] = c->code;
+        c->codepos = c->pos++;
+        c->code    = 1U;
+        return;
+    }
+
+    c->dst[c->pos++] = b;
+    c->code++;
+
+    if (c->code == 0xFFU)
+    {
+        c->dst[c->codepos] = c->code;
+        c->codepos = c->pos++;
+        c->code    = 1U;
+    }
+}
+
+static unsigned int Telemetry_CobsEnd(TELEMETRY_COBS_T *c)
+{
+    c->dst[c->codepos] = c->code;
+
+    return c->pos;
+}
+
+unsigned int Telemetry_CobsEncode(const unsigned char *src, unsigned int len, unsigned char *dst)
+{
+    TELEMETRY_COBS_T c;
+    unsigned int i;
+
+    Telemetry_CobsBegin(&c, dst);
+
+    for (i = 0U; i < len; i++)
+    {
+        Telemetry_CobsPut(&c, src[i]);
+    }
+
+    return Telemetry_CobsEnd(&c);
+}
+
+/*
+ * read payload in place , build frame in g_Telemetry.frame
+ * return 0 , -1 if CRC engine busy (frame not built)
+ */
+static int Telemetry_BuildFrame(TELEMETRY_PKT_T *pkt)
+{
+    volatile TELEMETRY_T *t;
+    TELEMETRY_COBS_T c;
+    unsigned long crc;
+    unsigned char hdr[2];
+    unsigned int i;
+    unsigned int n;
+
+    t = &g_Telemetry;
+
+    hdr[0] = pkt->type;
+    hdr[1] = t->seq;
+
+    /* CRC-32 IEEE : reflected in / out , final xor */
+    CrcService_Reset(&s_TelemetryCrc);
+    if ((CrcService_Update(&s_TelemetryCrc, hdr, 2UL) != 0) ||
+        (CrcService_Update(&s_TelemetryCrc, pkt->payload, pkt->len) != 0))
+    {
+        return -1;
+    }
+    crc = CrcService_Final(&s_TelemetryCrc);
+
+    t->frame[0] = 0x00U;        /* leading delimiter : resync after noise */
+    Telemetry_CobsBegin(&c, (unsigned char *)&t->frame[1]);
+
+    Telemetry_CobsPut(&c, hdr[0]);
+    Telemetry_CobsPut(&c, hdr[1]);
+
+    for (i = 0U; i < pkt->len; i++)
+    {
+        Telemetry_CobsPut(&c, pkt->payload[i]);
+    }
+
+    Telemetry_CobsPut(&c, (unsigned char)(crc));
+    Telemetry_CobsPut(&c, (unsigned char)(crc >> 8));
+    Telemetry_CobsPut(&c, (unsigned char)(crc >> 16));
+    Telemetry_CobsPut(&c, (unsigned char)(crc >> 24));
+
+    n = Telemetry_CobsEnd(&c);
+
+    t->frame[1U + n] = 0x00U;
+    t->flen = (unsigned short)(n + 2U);
+    t->foff = 0U;
+    t->seq++;
+
+    return 0;
+}
+
+/* return 1 if whole frame is in sink */
+static int Telemetry_Flush(void)
+{
+    volatile TELEMETRY_T *t;
+    unsigned int n;
+
+    t = &g_Telemetry;
+
+    while (t->foff < t->flen)
+    {
+        n = t->sink((const unsigned char *)&t->frame[t->foff], (unsigned int)(t->flen - t->foff));
+        if (n == 0U)
+        {
+            return 0;
+        }
+
+        t->foff = (unsigned short)(t->foff + n);
+        t->bytecnt += n;
+    }
+
+    return 1;
+}
+
+/*
+ * come back from retry timer , not a self post : TimerService_Dispatch run until no deferred call is left ,
+ * an immediate re-post would spin there until the sink drain
+ */
+static void Telemetry_Retry(void)
+{
+    volatile TELEMETRY_T *t;
+    t = &g_Telemetry;
+
+    t->stallcnt++;
+
+    /* no timer : next submit will post */
+    if ((t->retry == 0U) && (g_TelemetryTimerId >= 0))
+    {
+        t->retry = 1U;
+        TimerService_StartTimer((unsigned int)g_TelemetryTimerId);
+    }
+}
+
+/* retry timer , one shot */
+static void Telemetry_RetryTick(void *user_data)
+{
+    TimerService_StopTimer((unsigned int)g_TelemetryTimerId);
+    g_Telemetry.retry = 0U;
+
+    Telemetry_Process(user_data);
+}
+
+void Telemetry_Process(void *user_data)
+{
+    volatile TELEMETRY_T *t;
+    TELEMETRY_PKT_T *pkt;
+    uint32_t primask;
+
+    (void)user_data;
+
+    t = &g_Telemetry;
+    t->posted = 0U;
+
+    for (;;)
+    {
+        if (Telemetry_Flush() == 0)
+        {
+            /* output full : keep frame */
+            Telemetry_Retry();
+            return;
+        }
+
+        /* head only leave the queue here , stay in place while frame is built */
+        TELEMETRY_ENTER_CRITICAL(primask);
+        pkt = t->head;
+        TELEMETRY_EXIT_CRITICAL(primask);
+
+        if (pkt == (TELEMETRY_PKT_T *)0)
+        {
+            return;
+        }
+
+        if (Telemetry_BuildFrame(pkt) != 0)
+        {
+            /* CRC engine used by other stream : keep packet */
+            Telemetry_Retry();
+            return;
+        }
+        t->framecnt++;
+
+        TELEMETRY_ENTER_CRITICAL(primask);
+        t->head = pkt->next;
+        if (t->head == (TELEMETRY_PKT_T *)0)
+        {
+            t->tail = (TELEMETRY_PKT_T *)0;
+        }
+        TELEMETRY_EXIT_CRITICAL(primask);
+
+        /* payload already encoded : give packet back to producer */
+        pkt->state = TELEMETRY_PKT_IDLE;
+    }
+}
+
+int Telemetry_Submit(TELEMETRY_PKT_T *pkt, unsigned char type, const unsigned char *payload, unsigned short len)
+{
+    volatile TELEMETRY_T *t;
+    uint32_t primask;
+
+    if ((pkt == (TELEMETRY_PKT_T *)0) || (len > TELEMETRY_MAX_PAYLOAD) ||
+        ((payload == (const unsigned char *)0) && (len != 0U)))
+    {
+        return -1;
+    }
+
+    t = &g_Telemetry;
+
+    TELEMETRY_ENTER_CRITICAL(primask);
+
+    if (pkt->state != TELEMETRY_PKT_IDLE)
+    {
+        TELEMETRY_EXIT_CRITICAL(primask);
+        return -1;
+    }
+
+    pkt->next    = (TELEMETRY_PKT_T *)0;
+    pkt->payload = payload;
+    pkt->len     = len;
+    pkt->type    = type;
+    pkt->state   = TELEMETRY_PKT_QUEUED;
+
+    if (t->tail == (TELEMETRY_PKT_T *)0)
+    {
+        t->head = pkt;
+    }
+    else
+    {
+        t->tail->next = pkt;
+    }
+    t->tail = pkt;
+
+    if (t->posted == 0U)
+    {
+        if (TimerService_Post(Telemetry_Process, (void *)0) == 0)
+        {
+            t->posted = 1U;
+        }
+    }
+
+    TELEMETRY_EXIT_CRITICAL(primask);
+
+    return 0;
+}
+
+int Telemetry_IsBusy(const TELEMETRY_PKT_T *pkt)
+{
+    return (pkt->state != TELEMETRY_PKT_IDLE) ? 1 : 0;
+}
+
+/* debug UART : whole frame or nothing , no blocking */
+static unsigned int Telemetry_DefaultSink(const unsigned char *data, unsigned int len)
+{
+    #if defined (DEBUG_TX_IRQ)
+    return (DebugTx_WriteRaw((const uint8_t *)data, (uint32_t)len) == 0) ? len : 0U;
+    #else
+    unsigned int i;
+
+    for (i = 0U; i < len; i++)
+    {
+        SendChar_ToUART(data[i]);
+    }
+
+    return len;
+    #endif
+}
+
+void Telemetry_Init(TELEMETRY_SINK_T sink)
+{
+    volatile TELEMETRY_T *t;
+    t = &g_Telemetry;
+
+    t->head     = (TELEMETRY_PKT_T *)0;
+    t->tail     = (TELEMETRY_PKT_T *)0;
+    t->sink     = (sink != (TELEMETRY_SINK_T)0) ? sink : Telemetry_DefaultSink;
+    t->flen     = 0U;
+    t->foff     = 0U;
+    t->seq      = 0U;
+    t->posted   = 0U;
+    t->retry    = 0U;
+    t->framecnt = 0UL;
+    t->bytecnt  = 0UL;
+    t->stallcnt = 0UL;
+
+    CrcService_CtxInit(&s_TelemetryCrc, CRC_SERVICE_CRC32);
+
+    /* created stopped , run only while a frame wait for the sink or CRC engine */
+    if (g_TelemetryTimerId < 0)
+    {
+        g_TelemetryTimerId = TimerService_CreateTimerQueue(TELEMETRY_RETRY_MS, Telemetry_RetryTick, (void *)0);
+    }
+}
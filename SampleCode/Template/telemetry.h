@@ -0,0 +1,77 @@
+#ifndef __TELEMETRY_H__
+#define __TELEMETRY_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * frame on wire : 0x00 | COBS( type | seq | payload | CRC-32 LE ) | 0x00
+ * CRC-32 (IEEE 802.3 , reflected , init 0xFFFFFFFF , xorout 0xFFFFFFFF) by CRC peripheral (crc_service.c)
+ * over type | seq | payload , decode with Tools/telemetry_decode.c
+ */
+#define TELEMETRY_MAX_PAYLOAD                   (128U)
+#define TELEMETRY_RAW_MAX                       (2U + TELEMETRY_MAX_PAYLOAD + 4U)
+#define TELEMETRY_FRAME_MAX                     (1U + TELEMETRY_RAW_MAX + ((TELEMETRY_RAW_MAX + 253U) / 254U) + 1U)
+#define TELEMETRY_RETRY_MS                      (2U)      /* sink full or CRC busy : try again after */
+
+/* packet type */
+#define TELEMETRY_TYPE_TIMER_STATS              (0x01U)
+#define TELEMETRY_TYPE_SENSOR                   (0x02U)
+
+/* packet state */
+#define TELEMETRY_PKT_IDLE                      (0U)      /* owned by producer */
+#define TELEMETRY_PKT_QUEUED                    (1U)      /* owned by telemetry , payload must not change */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* producer owned , linked into send queue without copy */
+typedef struct _telemetry_pkt_t
+{
+    struct _telemetry_pkt_t *next;
+    const unsigned char     *payload;
+    unsigned short           len;
+    unsigned char            type;
+    volatile unsigned char   state;
+
+} TELEMETRY_PKT_T;
+
+/* return number of byte accepted , 0 if output full */
+typedef unsigned int (*TELEMETRY_SINK_T)(const unsigned char *data, unsigned int len);
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/* little endian payload field */
+#define TELEMETRY_PUT_U16(p, v)                 do { (p)[0] = (unsigned char)(v); (p)[1] = (unsigned char)((v) >> 8); } while (0)
+#define TELEMETRY_PUT_U32(p, v)                 do { TELEMETRY_PUT_U16((p), (v)); TELEMETRY_PUT_U16((p) + 2, (unsigned long)(v) >> 16); } while (0)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after TimerService_Init and CrcService_Init , take one queue timer */
+void Telemetry_Init(TELEMETRY_SINK_T sink);
+
+/*
+ * ISR safe , pkt stay TELEMETRY_PKT_QUEUED until its payload is encoded into the internal frame ,
+ * back to TELEMETRY_PKT_IDLE before the frame reach the sink
+ * return 0  : queued
+ *        -1 : already queued , payload too long or invalid
+ */
+int  Telemetry_Submit(TELEMETRY_PKT_T *pkt, unsigned char type, const unsigned char *payload, unsigned short len);
+
+int  Telemetry_IsBusy(const TELEMETRY_PKT_T *pkt);
+
+/* encoder , posted on submit , run in TimerService_Dispatch */
+void Telemetry_Process(void *user_data);
+
+unsigned long Telemetry_GetFrameCnt(void);
+unsigned long Telemetry_GetByteCnt(void);
+unsigned long Telemetry_GetStallCnt(void);
+
+/* COBS , dst size at least len + (len / 254) + 1 , return encoded length (no delimiter) */
+unsigned int Telemetry_CobsEncode(const unsigned char *src, unsigned int len, unsigned char *dst);
+
+#endif //__TELEMETRY_H__
@@ -0,0 +1,186 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NuMicro.h"
+
+#include "timer_cli.h"
+#include "timer_service.h"
+#include "shell.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * decimal or 0x hex argument
+ * return 0  : *value valid
+ *        -1 : not a number or above max
+ */
+static int TimerCli_ParseNum(const char *s, unsigned long max, unsigned long *value)
+{
+    char *end;
+    unsigned long v;
+
+    if ((s == (const char *)0) || (*s == '\0') || (*s == '-'))
+    {
+        return -1;
+    }
+
+    v = strtoul(s, &end, 0);
+    if ((*end != '\0') || (v > max))
+    {
+        return -1;
+    }
+
+    *value = v;
+
+    return 0;
+}
+
+/* argv[1] is a created timer id */
+static int TimerCli_ParseId(int argc, char *argv[], unsigned int *timer_id)
+{
+    TIMER_INSTANCE_T info;
+    unsigned long v;
+
+    if ((argc < 2) || (TimerCli_ParseNum(argv[1], TIMER_SERVICE_MAX_TIMERS - 1U, &v) != 0))
+    {
+        printf("invalid id\r\n");
+        return -1;
+    }
+
+    if (TimerService_GetInfo((unsigned int)v, &info) != 0)
+    {
+        printf("timer %lu not created\r\n", v);
+        return -1;
+    }
+
+    *timer_id = (unsigned int)v;
+
+    return 0;
+}
+
+static int TimerCli_CmdList(int argc, char *argv[])
+{
+    TIMER_INSTANCE_T info;
+    unsigned int i;
+
+    (void)argc;
+    (void)argv;
+
+    printf("id kind  period counter act pend wcet_us     runcnt\r\n");
+
+    for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
+    {
+        if (TimerService_GetInfo(i, &info) != 0)
+        {
+            continue;
+        }
+
+        printf("%2u %-5s %6u %7u %3u %4u %7u %10lu\r\n",
+               i,
+               (info.kind == TIMER_KIND_FLAG) ? "flag" : "queue",
+               (unsigned int)info.period_ms,
+               (unsigned int)info.counter_ms,
+               (unsigned int)info.active,
+               (unsigned int)info.pending,
+               (unsigned int)info.wcet_us,
+               info.runcnt);
+    }
+
+    return 0;
+}
+
+static int TimerCli_CmdStat(int argc, char *argv[])
+{
+    if ((argc >= 2) && (strcmp(argv[1], "clr") == 0))
+    {
+        TimerService_ClearQueueStats();
+        printf("cleared\r\n");
+        return 0;
+    }
+
+    printf("tick           : %lu ms\r\n", TimerService_GetTick());
+    printf("queue          : maxused %u / %u , overflow %lu\r\n",
+           (unsigned int)TimerService_GetQueueMaxUsed(), (unsigned int)TIMER_EVENT_QUEUE_SIZE,
+           TimerService_GetQueueOverflowCnt());
+    printf("deferred call  : maxused %u / %u , overflow %lu\r\n",
+           (unsigned int)TimerService_GetPostMaxUsed(), (unsigned int)TIMER_DEFER_QUEUE_SIZE,
+           TimerService_GetPostOverflowCnt());
+    printf("budget exhaust : %lu\r\n", TimerService_GetBudgetExhaustedCnt());
+    printf("utilization    : %lu / %lu permille\r\n",
+           TimerService_GetUtilization(), TimerService_GetUtilizationLimit());
+
+    return 0;
+}
+
+static int TimerCli_CmdPeriod(int argc, char *argv[])
+{
+    unsigned int timer_id;
+    unsigned long ms;
+
+    if (TimerCli_ParseId(argc, argv, &timer_id) != 0)
+    {
+        return -1;
+    }
+
+    if ((argc < 3) || (TimerCli_ParseNum(argv[2], 0xFFFFUL, &ms) != 0))
+    {
+        printf("usage : tperiod <id> <ms 0..65535>\r\n");
+        return -1;
+    }
+
+    TimerService_ChangePeriod(timer_id, (unsigned short)ms);
+    printf("timer %u period %lu ms\r\n", timer_id, ms);
+
+    return 0;
+}
+
+static int TimerCli_CmdStart(int argc, char *argv[])
+{
+    unsigned int timer_id;
+
+    if (TimerCli_ParseId(argc, argv, &timer_id) != 0)
+    {
+        return -1;
+    }
+
+    TimerService_StartTimer(timer_id);
+    printf("timer %u started\r\n", timer_id);
+
+    return 0;
+}
+
+static int TimerCli_CmdStop(int argc, char *argv[])
+{
+    unsigned int timer_id;
+
+    if (TimerCli_ParseId(argc, argv, &timer_id) != 0)
+    {
+        return -1;
+    }
+
+    TimerService_StopTimer(timer_id);
+    printf("timer %u stopped\r\n", timer_id);
+
+    return 0;
+}
+
+static const SHELL_CMD_T s_TimerCliTable[TIMER_CLI_CMD_NUM] =
+{
+    {"tlist",   TimerCli_CmdList,   "list timer slot"},
+    {"tstat",   TimerCli_CmdStat,   "timer service statistic , tstat clr"},
+    {"tperiod", TimerCli_CmdPeriod, "tperiod <id> <ms>"},
+    {"tstart",  TimerCli_CmdStart,  "tstart <id>"},
+    {"tstop",   TimerCli_CmdStop,   "tstop <id>"},
+};
+
+int TimerCli_Register(void)
+{
+    return Shell_RegisterTable(s_TimerCliTable, TIMER_CLI_CMD_NUM);
+}
@@ -0,0 +1,29 @@
+#ifndef __TIMER_CLI_H__
+#define __TIMER_CLI_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * shell command for TimerService , tune on running unit
+ *   tlist                  : all slot (id, kind, period, counter, active, pending, wcet, run count)
+ *   tstat [clr]            : queue / deferred call / dispatch statistic , utilization
+ *   tperiod <id> <ms>      : change period
+ *   tstart <id>            : start timer
+ *   tstop <id>             : stop timer
+ */
+
+#define TIMER_CLI_CMD_NUM                       (5U)      /* shell slot used by TimerCli_Register */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after Shell_Init , return number of command registered */
+int  TimerCli_Register(void);
+
+#endif //__TIMER_CLI_H__
@@ -0,0 +1,155 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_schedule.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile TIMER_SCHEDULE_T g_TimerSchedule;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long TimerSchedule_GetOverrunCnt(void)
+{
+    return g_TimerSchedule.overruncnt;
+}
+
+unsigned char TimerSchedule_GetLastOverrunFrame(void)
+{
+    return g_TimerSchedule.lastoverrun;
+}
+
+/* worst frame end time, in permille of minor frame */
+unsigned long TimerSchedule_GetMaxLoadPermille(void)
+{
+    volatile TIMER_SCHEDULE_T *s;
+    unsigned long cmp;
+
+    s = &g_TimerSchedule;
+
+    if (s->timer == (TIMER_T *)0)
+    {
+        return 0UL;
+    }
+
+    cmp = s->timer->CMP;
+    if (cmp == 0UL)
+    {
+        return 0UL;
+    }
+
+    return (s->maxcounter * 1000UL) / cmp;
+}
+
+void TimerSchedule_ClearStats(void)
+{
+    volatile TIMER_SCHEDULE_T *s;
+    s = &g_TimerSchedule;
+
+    s->overruncnt  = 0UL;
+    s->maxcounter  = 0UL;
+    s->lastoverrun = 0U;
+}
+
+/* minor frame : proceed in timer irq */
+void TimerSchedule_Tick1ms(void)
+{
+    volatile TIMER_SCHEDULE_T *s;
+    const TIMER_SCHEDULE_FRAME_T *f;
+    const TIMER_SCHEDULE_SLOT_T *slot;
+    unsigned long cnt;
+    unsigned char i;
+
+    s = &g_TimerSchedule;
+
+    if ((s->active == 0U) || (s->frames == (const TIMER_SCHEDULE_FRAME_T *)0))
+    {
+        return;
+    }
+
+    f = &s->frames[s->index];
+
+    for (i = 0U; i < f->count; i++)
+    {
+        slot = &f->slots[i];
+
+        if (slot->callback != (TIMER_CALLBACK_T)0)
+        {
+            slot->callback(slot->user_data);
+        }
+    }
+
+    /* next tick already arrived : this frame run over its boundary */
+    if (TIMER_GetIntFlag(s->timer) == 1)
+    {
+        s->overruncnt++;
+        s->lastoverrun = s->index;
+    }
+    else
+    {
+        cnt = TIMER_GetCounter(s->timer);
+        if (cnt > s->maxcounter)
+        {
+            s->maxcounter = cnt;
+        }
+    }
+
+    s->index++;
+    if (s->index >= s->framecnt)
+    {
+        s->index = 0U;
+    }
+}
+
+void TimerSchedule_Stop(void)
+{
+    g_TimerSchedule.active = 0U;
+}
+
+void TimerSchedule_Start(void)
+{
+    volatile TIMER_SCHEDULE_T *s;
+    s = &g_TimerSchedule;
+
+    if (s->frames == (const TIMER_SCHEDULE_FRAME_T *)0)
+    {
+        return;
+    }
+
+    s->index  = 0U;
+    s->active = 1U;
+}
+
+int TimerSchedule_Init(const TIMER_SCHEDULE_FRAME_T *frames,
+                       unsigned char frame_count,
+                       TIMER_T *timer)
+{
+    volatile TIMER_SCHEDULE_T *s;
+
+    s = &g_TimerSchedule;
+
+    s->active = 0U;
+
+    if ((frames == (const TIMER_SCHEDULE_FRAME_T *)0) ||
+        (frame_count == 0U) ||
+        (timer == (TIMER_T *)0))
+    {
+        s->frames = (const TIMER_SCHEDULE_FRAME_T *)0;
+        return -1;
+    }
+
+    s->frames      = frames;
+    s->timer       = timer;
+    s->framecnt    = frame_count;
+    s->index       = 0U;
+    s->overruncnt  = 0UL;
+    s->maxcounter  = 0UL;
+    s->lastoverrun = 0U;
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#ifndef __TIMER_SCHEDULE_H__
+#define __TIMER_SCHEDULE_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * cyclic executive (time-triggered schedule table)
+ * one minor frame per TMR tick, slots of the frame run in table order inside the TMR IRQ
+ */
+#define TIMER_SCHEDULE_MINOR_FRAME_US           (1000U)
+#define TIMER_SCHEDULE_FRAME_BUDGET_US          (TIMER_SCHEDULE_MINOR_FRAME_US * 80U / 100U)  /* keep 20% for other ISR */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+typedef struct _timer_schedule_slot_t
+{
+    TIMER_CALLBACK_T callback;
+    void            *user_data;
+    unsigned short   wcet_us;       /* declared worst case execution time */
+
+} TIMER_SCHEDULE_SLOT_T;
+
+typedef struct _timer_schedule_frame_t
+{
+    const TIMER_SCHEDULE_SLOT_T *slots;
+    unsigned char                count;
+
+} TIMER_SCHEDULE_FRAME_T;
+
+typedef struct _timer_schedule_t
+{
+    const TIMER_SCHEDULE_FRAME_T *frames;
+    TIMER_T                      *timer;
+    unsigned long                 overruncnt;
+    unsigned long                 maxcounter;    /* max TMR counter at frame end */
+    unsigned char                 framecnt;
+    unsigned char                 index;
+    unsigned char                 lastoverrun;   /* frame index of last overrun */
+    unsigned char                 active;
+
+} TIMER_SCHEDULE_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*
+	usage :
+
+	#define FRAME0_SLOTS(X)     X(Task_Ctrl, (void *)0, 200U) X(Task_Adc, (void *)0, 150U)
+	#define FRAME1_SLOTS(X)     X(Task_Ctrl, (void *)0, 200U) X(Task_Comm, (void *)0, 300U)
+
+	TIMER_SCHEDULE_DEFINE_FRAME(frame0, FRAME0_SLOTS);
+	TIMER_SCHEDULE_DEFINE_FRAME(frame1, FRAME1_SLOTS);
+
+	static const TIMER_SCHEDULE_FRAME_T schedule[] =
+	{
+		TIMER_SCHEDULE_FRAME(frame0),
+		TIMER_SCHEDULE_FRAME(frame1),
+	};
+
+	frame with sum of wcet_us > TIMER_SCHEDULE_FRAME_BUDGET_US will fail to compile
+*/
+
+#define TIMER_SCHEDULE_SLOT_INIT(cb, arg, wcet) { (cb), (arg), (wcet) },
+#define TIMER_SCHEDULE_SLOT_WCET(cb, arg, wcet) + (unsigned long)(wcet)
+
+#define TIMER_SCHEDULE_DEFINE_FRAME(name, list) \
+    typedef char name##_wcet_overflow[((0UL list(TIMER_SCHEDULE_SLOT_WCET)) <= TIMER_SCHEDULE_FRAME_BUDGET_US) ? 1 : -1]; \
+    static const TIMER_SCHEDULE_SLOT_T name[] = { list(TIMER_SCHEDULE_SLOT_INIT) }
+
+#define TIMER_SCHEDULE_FRAME(name)              { (name), (unsigned char)(sizeof(name) / sizeof((name)[0])) }
+#define TIMER_SCHEDULE_FRAME_IDLE               { (const TIMER_SCHEDULE_SLOT_T *)0, 0U }
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/*
+ * timer : the TMR which drive TimerSchedule_Tick1ms(), used for overrun check
+ * return 0  : ok
+ *        -1 : invalid table
+ */
+int  TimerSchedule_Init(const TIMER_SCHEDULE_FRAME_T *frames,
+                        unsigned char frame_count,
+                        TIMER_T *timer);
+
+void TimerSchedule_Start(void);
+void TimerSchedule_Stop(void);
+
+/* minor frame hook, must be called from TMR IRQ before TimerService_Tick1ms */
+void TimerSchedule_Tick1ms(void);
+
+unsigned long TimerSchedule_GetOverrunCnt(void);
+unsigned char TimerSchedule_GetLastOverrunFrame(void);
+unsigned long TimerSchedule_GetMaxLoadPermille(void);
+void TimerSchedule_ClearStats(void);
+
+#endif //__TIMER_SCHEDULE_H__
@@ -2,19 +2,56 @@
 #include <stdio.h>
 #include "NuMicro.h"
 
+#include "misc_config.h"
 #include "timer_service.h"
 
+#define LOG_MODULE                              LOG_MOD_TIMER
+#include "log.h"
+
 /*_____ D E C L A R A T I O N S ____________________________________________*/
 
+#define TIMER_DEFER_QUEUE_MASK                  (TIMER_DEFER_QUEUE_SIZE - 1U)
+
+/* dispatch source, served round-robin */
+#define TIMER_DISPATCH_SOURCE_QUEUE             (0U)
+#define TIMER_DISPATCH_SOURCE_DEFER             (1U)
+#define TIMER_DISPATCH_SOURCE_FLAG              (2U)
+#define TIMER_DISPATCH_SOURCE_NUM               (3U)
+
+typedef struct _timer_dispatch_t
+{
+    unsigned long  exhaustedcnt;    /* budget used up while work still pending */
+    unsigned char  source;          /* next source to serve */
+    unsigned char  flagscan;        /* next flag-based timer to check */
+    unsigned char  reserved[2];
+
+} TIMER_DISPATCH_T;
+
+/* TIMER_DEFER_QUEUE_SIZE must be power of 2 and fit in unsigned char index */
+typedef char timer_defer_queue_size_check[((TIMER_DEFER_QUEUE_SIZE & TIMER_DEFER_QUEUE_MASK) == 0U) &&
+                                          (TIMER_DEFER_QUEUE_SIZE <= 128U) ? 1 : -1];
+
 /*_____ D E F I N I T I O N S ______________________________________________*/
 
 volatile TIMER_EVENT_QUEUE_T g_TimerEventQueue;
 volatile TIMER_INSTANCE_T    g_TimerService_List[TIMER_SERVICE_MAX_TIMERS];
+volatile TIMER_DEFER_QUEUE_T g_TimerDeferQueue;
+volatile unsigned long       g_TimerService_TickMs;
+volatile TIMER_DISPATCH_T    g_TimerDispatch;
 
 /*_____ M A C R O S ________________________________________________________*/
 
+/* short critical section, interrupt state is restored on exit (nest safe) */
+#define TIMER_SERVICE_ENTER_CRITICAL(m)         do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define TIMER_SERVICE_EXIT_CRITICAL(m)          __set_PRIMASK(m)
+
 /*_____ F U N C T I O N S __________________________________________________*/
 
+unsigned long TimerService_GetTick(void)
+{
+    return g_TimerService_TickMs;
+}
+
 unsigned char TimerService_GetQueueMaxUsed(void)
 {
     volatile TIMER_EVENT_QUEUE_T *q;
@@ -38,9 +75,158 @@ void TimerService_ClearQueueStats(void)
 
     q->maxused = 0U;
     q->overflowcnt = 0UL;
+
+    g_TimerDeferQueue.maxused = 0U;
+    g_TimerDeferQueue.overflowcnt = 0UL;
+
+    g_TimerDispatch.exhaustedcnt = 0UL;
+}
+
+unsigned char TimerService_GetPostMaxUsed(void)
+{
+    return g_TimerDeferQueue.maxused;
+}
+
+unsigned long TimerService_GetPostOverflowCnt(void)
+{
+    return g_TimerDeferQueue.overflowcnt;
+}
+
+/* deferred call : any ISR or main loop */
+int TimerService_Post(TIMER_CALLBACK_T cb, void *user_data)
+{
+    volatile TIMER_DEFER_QUEUE_T *q;
+    volatile TIMER_DEFER_ENTRY_T *e;
+    unsigned char used;
+    uint32_t primask;
+
+    if (cb == (TIMER_CALLBACK_T)0)
+    {
+        return -1;
+    }
+
+    q = &g_TimerDeferQueue;
+
+    /* producers may preempt each other, only the slot reservation is protected */
+    TIMER_SERVICE_ENTER_CRITICAL(primask);
+
+    used = (unsigned char)(q->tail - q->head);
+    if (used >= TIMER_DEFER_QUEUE_SIZE)
+    {
+        q->overflowcnt++;
+        TIMER_SERVICE_EXIT_CRITICAL(primask);
+        return -1;
+    }
+
+    e = &q->entry[q->tail & TIMER_DEFER_QUEUE_MASK];
+    e->callback  = cb;
+    e->user_data = user_data;
+    q->tail++;
+
+    used++;
+    if (used > q->maxused)
+    {
+        q->maxused = used;
+    }
+
+    TIMER_SERVICE_EXIT_CRITICAL(primask);
+
+    return 0;
 }
 
 
+#if defined (TIMER_SERVICE_ENABLE_EDF)
+/* wrap-safe deadline compare : a earlier than b */
+#define TIMER_DEADLINE_BEFORE(a, b)             ((long)((a) - (b)) < 0L)
+
+/* enqueue in ISR (queue-based timer only) : heap insert, sift up */
+static void TimerService_EnqueueEventFromISR(int timer_id)
+{
+    volatile TIMER_EVENT_QUEUE_T *q;
+    unsigned char i;
+    unsigned char parent;
+    unsigned long deadline;
+
+    q = &g_TimerEventQueue;
+
+    if (q->count >= TIMER_EVENT_QUEUE_SIZE)
+    {
+        /* overflow, drop event or set error flag, and drop */
+        q->overflowcnt++;
+        return;
+    }
+
+    deadline = g_TimerService_TickMs + g_TimerService_List[timer_id].period_ms;
+
+    i = q->count;
+    while (i > 0U)
+    {
+        parent = (unsigned char)((i - 1U) >> 1);
+        if (!TIMER_DEADLINE_BEFORE(deadline, q->deadline[parent]))
+        {
+            break;
+        }
+        q->ids[i]      = q->ids[parent];
+        q->deadline[i] = q->deadline[parent];
+        i = parent;
+    }
+    q->ids[i]      = timer_id;
+    q->deadline[i] = deadline;
+
+    q->count++;
+
+    if (q->count > q->maxused)
+    {
+        q->maxused = q->count;
+    }
+}
+
+/* dequeue in main loop : heap remove root, sift down , caller must hold critical section */
+static int TimerService_DequeueEvent(void)
+{
+    volatile TIMER_EVENT_QUEUE_T *q;
+    int id;
+    int last_id;
+    unsigned long last_deadline;
+    unsigned char i;
+    unsigned char child;
+
+    q = &g_TimerEventQueue;
+
+    id = q->ids[0];
+    q->count--;
+
+    last_id       = q->ids[q->count];
+    last_deadline = q->deadline[q->count];
+
+    i = 0U;
+    for (;;)
+    {
+        child = (unsigned char)((i << 1) + 1U);
+        if (child >= q->count)
+        {
+            break;
+        }
+        if (((unsigned char)(child + 1U) < q->count) &&
+            TIMER_DEADLINE_BEFORE(q->deadline[child + 1U], q->deadline[child]))
+        {
+            child++;
+        }
+        if (!TIMER_DEADLINE_BEFORE(q->deadline[child], last_deadline))
+        {
+            break;
+        }
+        q->ids[i]      = q->ids[child];
+        q->deadline[i] = q->deadline[child];
+        i = child;
+    }
+    q->ids[i]      = last_id;
+    q->deadline[i] = last_deadline;
+
+    return id;
+}
+
+#else
 /* enqueue in ISR (queue-based timer only) */
 static void TimerService_EnqueueEventFromISR(int timer_id)
 {
@@ -69,12 +255,35 @@ static void TimerService_EnqueueEventFromISR(int timer_id)
     }
 
 }
+
+/* dequeue in main loop : FIFO order , caller must hold critical section */
+static int TimerService_DequeueEvent(void)
+{
+    volatile TIMER_EVENT_QUEUE_T *q;
+    int id;
+
+    q = &g_TimerEventQueue;
+
+    id = q->ids[q->head];
+    q->head++;
+    if (q->head >= TIMER_EVENT_QUEUE_SIZE)
+    {
+        q->head = 0U;
+    }
+    q->count--;
+
+    return id;
+}
+#endif /* TIMER_SERVICE_ENABLE_EDF */
+
 /* 1 ms tick: proceed in timer irq */
 void TimerService_Tick1ms(void)
 {
     unsigned int i;
     volatile TIMER_INSTANCE_T *p;
 
+    g_TimerService_TickMs++;
+
     for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
     {
         p = &g_TimerService_List[i];
@@ -108,46 +317,112 @@ void TimerService_Tick1ms(void)
     }
 }
 
-/* dispatch event IN main loop */
-void TimerService_Dispatch(void)
+/* execute timer callback , measure execution time if profile enabled */
+static void TimerService_RunCallback(unsigned int timer_id, TIMER_CALLBACK_T cb, void *user)
+{
+    #if defined (TIMER_SERVICE_ENABLE_PROFILE)
+    unsigned long start;
+    unsigned long us;
+
+    g_TimerService_List[timer_id].runcnt++;
+
+    start = get_systick_cycle();
+
+    cb(user);
+
+    us = (get_systick_cycle() - start) / (SystemCoreClock / 1000000UL);
+
+    TimerService_UpdateWcetHint(timer_id, (us > 0xFFFFUL) ? 0xFFFFU : (unsigned short)us);
+    #else
+    g_TimerService_List[timer_id].runcnt++;
+    cb(user);
+    #endif
+}
+
+/* proceed one queue-based timer event, return 1 if executed */
+static unsigned int TimerService_DispatchQueueOne(void)
 {
     volatile TIMER_EVENT_QUEUE_T *q;
-    int id;
+    volatile TIMER_INSTANCE_T *p;
     TIMER_CALLBACK_T cb;
     void *user;
-    volatile TIMER_INSTANCE_T *p;
-    unsigned int i;
+    int id;
+    uint32_t primask;
 
-    /* --- proceed queue-based timer event first --- */
     q = &g_TimerEventQueue;
 
-    while (q->count > 0U)
+    if (q->count == 0U)
     {
-        id = q->ids[q->head];
-        q->head++;
-        if (q->head >= TIMER_EVENT_QUEUE_SIZE)
+        return 0U;
+    }
+
+    /* queue is shared with TMR IRQ, read-modify-write must not be interrupted */
+    TIMER_SERVICE_ENTER_CRITICAL(primask);
+    id = TimerService_DequeueEvent();
+    TIMER_SERVICE_EXIT_CRITICAL(primask);
+
+    if ((id >= 0) && (id < (int)TIMER_SERVICE_MAX_TIMERS))
+    {
+        p = &g_TimerService_List[id];
+
+        cb   = p->callback;
+        user = p->user_data;
+
+        if (cb != (TIMER_CALLBACK_T)0)
         {
-            q->head = 0U;
+            TimerService_RunCallback((unsigned int)id, cb, user);
         }
-        q->count--;
+    }
 
-        if ((id >= 0) && (id < (int)TIMER_SERVICE_MAX_TIMERS))
-        {
-            p = &g_TimerService_List[id];
+    return 1U;
+}
 
-            cb   = p->callback;
-            user = p->user_data;
+/* proceed one deferred call from ISR, return 1 if executed */
+static unsigned int TimerService_DispatchDeferOne(void)
+{
+    volatile TIMER_DEFER_QUEUE_T *dq;
+    volatile TIMER_DEFER_ENTRY_T *e;
+    TIMER_CALLBACK_T cb;
+    void *user;
 
-            if (cb != (TIMER_CALLBACK_T)0)
-            {
-                cb(user);
-            }
-        }
+    dq = &g_TimerDeferQueue;
+
+    if (dq->head == dq->tail)
+    {
+        return 0U;
     }
 
-    /* --- then proceed flag-based timer pending flag --- */
-    for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
+    e = &dq->entry[dq->head & TIMER_DEFER_QUEUE_MASK];
+
+    cb   = e->callback;
+    user = e->user_data;
+
+    dq->head++;     /* release slot after entry is copied out */
+
+    cb(user);
+
+    return 1U;
+}
+
+/* proceed next pending flag-based timer, scan resume after last executed one */
+static unsigned int TimerService_DispatchFlagOne(void)
+{
+    volatile TIMER_INSTANCE_T *p;
+    TIMER_CALLBACK_T cb;
+    void *user;
+    unsigned int n;
+    unsigned int i;
+
+    for (n = 0U; n < TIMER_SERVICE_MAX_TIMERS; n++)
     {
+        i = g_TimerDispatch.flagscan;
+
+        g_TimerDispatch.flagscan++;
+        if (g_TimerDispatch.flagscan >= TIMER_SERVICE_MAX_TIMERS)
+        {
+            g_TimerDispatch.flagscan = 0U;
+        }
+
         p = &g_TimerService_List[i];
 
         if ((p->kind == TIMER_KIND_FLAG) &&
@@ -160,9 +435,106 @@ void TimerService_Dispatch(void)
             cb   = p->callback;
             user = p->user_data;
 
-            cb(user);
+            TimerService_RunCallback(i, cb, user);
+
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
+
+static unsigned int TimerService_HasPending(void)
+{
+    unsigned int i;
+    volatile TIMER_INSTANCE_T *p;
+
+    if ((g_TimerEventQueue.count != 0U) ||
+        (g_TimerDeferQueue.head != g_TimerDeferQueue.tail))
+    {
+        return 1U;
+    }
+
+    for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
+    {
+        p = &g_TimerService_List[i];
+
+        if ((p->kind == TIMER_KIND_FLAG) && (p->active != 0U) && (p->pending != 0U))
+        {
+            return 1U;
+        }
+    }
+
+    return 0U;
+}
+
+unsigned long TimerService_GetBudgetExhaustedCnt(void)
+{
+    return g_TimerDispatch.exhaustedcnt;
+}
+
+/* 
+ * dispatch event IN main loop, budgeted
+ * sources (queue-based / deferred call / flag-based) are served round-robin one callback at a time,
+ * next call resume from the source after the last served one
+ */
+unsigned int TimerService_DispatchBudget(unsigned int max_events)
+{
+    unsigned int done;
+    unsigned int ran;
+    unsigned char idle;
+
+    done = 0U;
+    idle = 0U;
+
+    while (idle < TIMER_DISPATCH_SOURCE_NUM)
+    {
+        if ((max_events != 0U) && (done >= max_events))
+        {
+            if (TimerService_HasPending() != 0U)
+            {
+                g_TimerDispatch.exhaustedcnt++;
+            }
+            break;
+        }
+
+        switch (g_TimerDispatch.source)
+        {
+            case TIMER_DISPATCH_SOURCE_QUEUE:
+                ran = TimerService_DispatchQueueOne();
+                break;
+            case TIMER_DISPATCH_SOURCE_DEFER:
+                ran = TimerService_DispatchDeferOne();
+                break;
+            default:
+                ran = TimerService_DispatchFlagOne();
+                break;
+        }
+
+        g_TimerDispatch.source++;
+        if (g_TimerDispatch.source >= TIMER_DISPATCH_SOURCE_NUM)
+        {
+            g_TimerDispatch.source = 0U;
+        }
+
+        if (ran != 0U)
+        {
+            done++;
+            idle = 0U;
+        }
+        else
+        {
+            idle++;
         }
     }
+
+    return done;
+}
+
+/* dispatch event IN main loop, until nothing pending */
+void TimerService_Dispatch(void)
+{
+    (void)TimerService_DispatchBudget(0U);
 }
 
 void TimerService_ChangePeriod(unsigned int timer_id,
@@ -216,44 +588,188 @@ void TimerService_StartTimer(unsigned int timer_id)
     p->active     = 1U;
 }
 
-/* create queue-based timer */
-int TimerService_CreateTimerQueue(unsigned short period_ms,
-                                  TIMER_CALLBACK_T cb,
-                                  void *user_data)
+#if !defined (TIMER_SERVICE_UTIL_LIMIT_PERMILLE) && !defined (TIMER_SERVICE_ENABLE_EDF)
+/* rate-monotonic bound n(2^(1/n)-1) in permille, rounded down */
+static const unsigned short s_TimerService_RmBound[TIMER_SERVICE_MAX_TIMERS] =
+{
+    1000U, 828U, 779U, 756U, 743U, 734U, 728U, 724U,
+     720U, 717U, 715U, 713U, 711U, 710U, 709U, 708U,
+};
+#endif
+
+/* wcet_us / (period_ms * 1000) * 1000 , rounded up */
+static unsigned long TimerService_UtilPermille(unsigned short period_ms, unsigned short wcet_us)
+{
+    if (period_ms == 0U)
+    {
+        period_ms = 1U;     /* period 0 expire every tick */
+    }
+
+    return ((unsigned long)wcet_us + period_ms - 1UL) / period_ms;
+}
+
+/* sum of created timers, n : number of timer with wcet hint */
+static unsigned long TimerService_SumUtilization(unsigned int *n)
 {
     unsigned int i;
+    unsigned long sum;
     volatile TIMER_INSTANCE_T *p;
 
+    sum = 0UL;
+    *n  = 0U;
+
     for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
     {
         p = &g_TimerService_List[i];
 
-        if (p->callback == (TIMER_CALLBACK_T)0)
+        if ((p->callback != (TIMER_CALLBACK_T)0) && (p->wcet_us != 0U))
         {
-            p->period_ms  = period_ms;
-            p->counter_ms = 0U;
-            p->active     = 0U;
-            p->kind       = TIMER_KIND_QUEUE;
-            p->pending    = 0U;
-            p->reserved   = 0U;
-            p->callback   = cb;
-            p->user_data  = user_data;
-
-            return (int)i;
+            sum += TimerService_UtilPermille(p->period_ms, p->wcet_us);
+            (*n)++;
         }
     }
 
-    return -1;
+    return sum;
 }
 
-/* create flag-based timer（for 1ms or high frequency task） */
-int TimerService_CreateTimerFlag(unsigned short period_ms,
-                                 TIMER_CALLBACK_T cb,
-                                 void *user_data)
+static unsigned long TimerService_UtilLimit(unsigned int n)
+{
+    #if defined (TIMER_SERVICE_UTIL_LIMIT_PERMILLE)
+    (void)n;
+    return TIMER_SERVICE_UTIL_LIMIT_PERMILLE;
+    #elif defined (TIMER_SERVICE_ENABLE_EDF)
+    (void)n;
+    return 1000UL;
+    #else
+    if (n == 0U)
+    {
+        n = 1U;
+    }
+    if (n > TIMER_SERVICE_MAX_TIMERS)
+    {
+        n = TIMER_SERVICE_MAX_TIMERS;
+    }
+    return s_TimerService_RmBound[n - 1U];
+    #endif
+}
+
+unsigned long TimerService_GetUtilization(void)
+{
+    unsigned int n;
+
+    return TimerService_SumUtilization(&n);
+}
+
+unsigned long TimerService_GetUtilizationLimit(void)
+{
+    unsigned int n;
+
+    (void)TimerService_SumUtilization(&n);
+
+    return TimerService_UtilLimit(n);
+}
+
+int TimerService_GetInfo(unsigned int timer_id, TIMER_INSTANCE_T *info)
+{
+    volatile TIMER_INSTANCE_T *p;
+    uint32_t primask;
+
+    if ((timer_id >= TIMER_SERVICE_MAX_TIMERS) || (info == (TIMER_INSTANCE_T *)0))
+    {
+        return -1;
+    }
+
+    p = &g_TimerService_List[timer_id];
+
+    /* counter_ms / pending change in timer irq */
+    TIMER_SERVICE_ENTER_CRITICAL(primask);
+
+    info->period_ms  = p->period_ms;
+    info->counter_ms = p->counter_ms;
+    info->wcet_us    = p->wcet_us;
+    info->active     = p->active;
+    info->kind       = p->kind;
+    info->pending    = p->pending;
+    info->reserved   = p->reserved;
+    info->runcnt     = p->runcnt;
+    info->callback   = p->callback;
+    info->user_data  = p->user_data;
+
+    TIMER_SERVICE_EXIT_CRITICAL(primask);
+
+    return (info->callback != (TIMER_CALLBACK_T)0) ? 0 : -1;
+}
+
+void TimerService_SetWcetHint(unsigned int timer_id, unsigned short wcet_us)
+{
+    if (timer_id >= TIMER_SERVICE_MAX_TIMERS)
+    {
+        return;
+    }
+
+    g_TimerService_List[timer_id].wcet_us = wcet_us;
+}
+
+void TimerService_UpdateWcetHint(unsigned int timer_id, unsigned short measured_us)
+{
+    volatile TIMER_INSTANCE_T *p;
+
+    if (timer_id >= TIMER_SERVICE_MAX_TIMERS)
+    {
+        return;
+    }
+
+    p = &g_TimerService_List[timer_id];
+
+    if (measured_us > p->wcet_us)
+    {
+        p->wcet_us = measured_us;
+    }
+}
+
+/* 
+ * return 0  : admitted
+ *        -2 : rejected
+ */
+static int TimerService_Admission(unsigned short period_ms, unsigned short wcet_us)
+{
+    unsigned int n;
+    unsigned long sum;
+    unsigned long limit;
+
+    if ((TIMER_SERVICE_ADMISSION_POLICY == TIMER_ADMISSION_NONE) || (wcet_us == 0U))
+    {
+        return 0;
+    }
+
+    sum   = TimerService_SumUtilization(&n) + TimerService_UtilPermille(period_ms, wcet_us);
+    limit = TimerService_UtilLimit(n + 1U);
+
+    if (sum <= limit)
+    {
+        return 0;
+    }
+
+    LOG_W("utilization %lu > %lu permille (period %u ms, wcet %u us)\r\n",
+          sum, limit, (unsigned int)period_ms, (unsigned int)wcet_us);
+
+    return (TIMER_SERVICE_ADMISSION_POLICY == TIMER_ADMISSION_REJECT) ? -2 : 0;
+}
+
+static int TimerService_CreateTimerKind(unsigned char kind,
+                                        unsigned short period_ms,
+                                        unsigned short wcet_us,
+                                        TIMER_CALLBACK_T cb,
+                                        void *user_data)
 {
     unsigned int i;
     volatile TIMER_INSTANCE_T *p;
 
+    if (TimerService_Admission(period_ms, wcet_us) != 0)
+    {
+        return -2;
+    }
+
     for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
     {
         p = &g_TimerService_List[i];
@@ -262,10 +778,12 @@ int TimerService_CreateTimerFlag(unsigned short period_ms,
         {
             p->period_ms  = period_ms;
             p->counter_ms = 0U;
+            p->wcet_us    = wcet_us;
             p->active     = 0U;
-            p->kind       = TIMER_KIND_FLAG;
+            p->kind       = kind;
             p->pending    = 0U;
             p->reserved   = 0U;
+            p->runcnt     = 0UL;
             p->callback   = cb;
             p->user_data  = user_data;
 
@@ -276,6 +794,38 @@ int TimerService_CreateTimerFlag(unsigned short period_ms,
     return -1;
 }
 
+/* create queue-based timer */
+int TimerService_CreateTimerQueue(unsigned short period_ms,
+                                  TIMER_CALLBACK_T cb,
+                                  void *user_data)
+{
+    return TimerService_CreateTimerKind(TIMER_KIND_QUEUE, period_ms, 0U, cb, user_data);
+}
+
+/* create flag-based timer（for 1ms or high frequency task） */
+int TimerService_CreateTimerFlag(unsigned short period_ms,
+                                 TIMER_CALLBACK_T cb,
+                                 void *user_data)
+{
+    return TimerService_CreateTimerKind(TIMER_KIND_FLAG, period_ms, 0U, cb, user_data);
+}
+
+int TimerService_CreateTimerQueueWcet(unsigned short period_ms,
+                                      unsigned short wcet_us,
+                                      TIMER_CALLBACK_T cb,
+                                      void *user_data)
+{
+    return TimerService_CreateTimerKind(TIMER_KIND_QUEUE, period_ms, wcet_us, cb, user_data);
+}
+
+int TimerService_CreateTimerFlagWcet(unsigned short period_ms,
+                                     unsigned short wcet_us,
+                                     TIMER_CALLBACK_T cb,
+                                     void *user_data)
+{
+    return TimerService_CreateTimerKind(TIMER_KIND_FLAG, period_ms, wcet_us, cb, user_data);
+}
+
 /* old API：default set as queue-based */
 int TimerService_CreateTimer(unsigned short period_ms,
                              TIMER_CALLBACK_T cb,
@@ -290,6 +840,8 @@ void TimerService_Init(void)
     volatile TIMER_INSTANCE_T *p;
     volatile TIMER_EVENT_QUEUE_T *q;
 
+    g_TimerService_TickMs = 0UL;
+
     /* Init event queue */
     q = &g_TimerEventQueue;
     q->head     = 0U;
@@ -297,6 +849,14 @@ void TimerService_Init(void)
     q->count    = 0U;
     q->reserved = 0U;
 
+    g_TimerDispatch.source   = 0U;
+    g_TimerDispatch.flagscan = 0U;
+
+    /* Init deferred call queue */
+    g_TimerDeferQueue.head     = 0U;
+    g_TimerDeferQueue.tail     = 0U;
+    g_TimerDeferQueue.reserved = 0U;
+
     /* Init timers */
     for (i = 0U; i < TIMER_SERVICE_MAX_TIMERS; i++)
     {
@@ -304,10 +864,12 @@ void TimerService_Init(void)
 
         p->period_ms  = 0U;
         p->counter_ms = 0U;
+        p->wcet_us    = 0U;
         p->active     = 0U;
         p->kind       = TIMER_KIND_QUEUE;
         p->pending    = 0U;
         p->reserved   = 0U;
+        p->runcnt     = 0UL;
         p->callback   = (TIMER_CALLBACK_T)0;
         p->user_data  = (void *)0;
     }
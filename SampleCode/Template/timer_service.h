@@ -9,6 +9,30 @@
 
 #define TIMER_SERVICE_MAX_TIMERS 				(16U)
 #define TIMER_EVENT_QUEUE_SIZE   				(16U)
+#define TIMER_DEFER_QUEUE_SIZE   				(16U)	/* must be power of 2 */
+#define TIMER_DISPATCH_MAX_EVENTS				(8U)	/* callback per loop() , 0 = no limit */
+
+/* 
+ * queue-based dispatch order
+ * undefined : FIFO arrival order
+ * defined   : earliest deadline first (deadline = arrival + period_ms), binary heap
+ */
+// #define TIMER_SERVICE_ENABLE_EDF
+
+/* 
+ * admission control at timer creation, based on declared wcet_us / period_ms
+ * limit : TIMER_SERVICE_UTIL_LIMIT_PERMILLE if defined,
+ *         else EDF bound (1000) or rate-monotonic bound n(2^(1/n)-1)
+ */
+#define TIMER_ADMISSION_NONE                    (0U)  /* no check */
+#define TIMER_ADMISSION_WARN                    (1U)  /* create timer, print warning */
+#define TIMER_ADMISSION_REJECT                  (2U)  /* do not create timer, return -2 */
+
+#define TIMER_SERVICE_ADMISSION_POLICY          (TIMER_ADMISSION_WARN)
+// #define TIMER_SERVICE_UTIL_LIMIT_PERMILLE    (700U)
+
+/* learn wcet_us hint from callback execution time in Dispatch (SysTick based , get_systick_cycle) */
+// #define TIMER_SERVICE_ENABLE_PROFILE
 
 /* timer type */
 #define TIMER_KIND_FLAG                         (0U)  /* flag-based, not into queue */
@@ -45,6 +69,9 @@ typedef struct _timer_event_queue_t
 {
     unsigned long  overflowcnt;
     int            ids[TIMER_EVENT_QUEUE_SIZE];
+    #if defined (TIMER_SERVICE_ENABLE_EDF)
+    unsigned long  deadline[TIMER_EVENT_QUEUE_SIZE];    /* heap order , same index as ids */
+    #endif
     unsigned char  head;
     unsigned char  tail;
     unsigned char  count;
@@ -55,14 +82,38 @@ typedef struct _timer_event_queue_t
 
 typedef void (*TIMER_CALLBACK_T)(void *user_data);
 
+typedef struct _timer_defer_entry_t
+{
+    TIMER_CALLBACK_T callback;
+    void            *user_data;
+
+} TIMER_DEFER_ENTRY_T;
+
+/* 
+ * deferred call queue : multi producer (any ISR / main loop), single consumer (dispatcher)
+ * head / tail are free running index, head is only written by consumer, tail only by producer
+ */
+typedef struct _timer_defer_queue_t
+{
+    unsigned long        overflowcnt;
+    TIMER_DEFER_ENTRY_T  entry[TIMER_DEFER_QUEUE_SIZE];
+    unsigned char        head;
+    unsigned char        tail;
+    unsigned char        maxused;
+    unsigned char        reserved;
+
+} TIMER_DEFER_QUEUE_T;
+
 typedef struct _timer_instance_t
 {
     unsigned short   period_ms;
     unsigned short   counter_ms;
+    unsigned short   wcet_us;       	/* worst case execution time hint, 0 = unknown */
     unsigned char    active;
     unsigned char    kind;        	/* TIMER_KIND_FLAG / TIMER_KIND_QUEUE */
     unsigned char    pending;      	/* flag-based: 1=callback wait to be executed; queue-based: reserved */
     unsigned char    reserved;
+    unsigned long    runcnt;        	/* callback executed count */
     TIMER_CALLBACK_T callback;
     void            *user_data;
 
@@ -73,10 +124,18 @@ typedef struct _timer_instance_t
 
 /*_____ F U N C T I O N S __________________________________________________*/
 
+/* 1 ms tick count since TimerService_Init */
+unsigned long TimerService_GetTick(void);
+
 unsigned char TimerService_GetQueueMaxUsed(void);
 unsigned long TimerService_GetQueueOverflowCnt(void);
 void TimerService_ClearQueueStats(void);
 
+unsigned long TimerService_GetBudgetExhaustedCnt(void);
+
+unsigned char TimerService_GetPostMaxUsed(void);
+unsigned long TimerService_GetPostOverflowCnt(void);
+
 /* init */
 void TimerService_Init(void);
 
@@ -98,6 +157,22 @@ int  TimerService_CreateTimerFlag(unsigned short period_ms,
                                   TIMER_CALLBACK_T cb,
                                   void *user_data);
 
+/* 
+ * same as above with worst case execution time hint for admission control
+ * return >=0 : timer ID
+ *        -1  : no free slot
+ *        -2  : rejected, utilization over limit (TIMER_ADMISSION_REJECT)
+ */
+int  TimerService_CreateTimerQueueWcet(unsigned short period_ms,
+                                       unsigned short wcet_us,
+                                       TIMER_CALLBACK_T cb,
+                                       void *user_data);
+
+int  TimerService_CreateTimerFlagWcet(unsigned short period_ms,
+                                      unsigned short wcet_us,
+                                      TIMER_CALLBACK_T cb,
+                                      void *user_data);
+
 /* reserved for queue-based */
 int  TimerService_CreateTimer(unsigned short period_ms,
                               TIMER_CALLBACK_T cb,
@@ -109,11 +184,41 @@ void TimerService_StopTimer(unsigned int timer_id);
 void TimerService_ChangePeriod(unsigned int timer_id,
                                unsigned short new_period_ms);
 
+/* 
+ * deferred call, safe to call from any ISR or main loop
+ * cb(user_data) will be executed later in TimerService_Dispatch()
+ * return 0  : posted
+ *        -1 : invalid callback or queue full
+ */
+int  TimerService_Post(TIMER_CALLBACK_T cb, void *user_data);
+
+/* wcet hint : set , or raise only if measured_us is larger */
+void TimerService_SetWcetHint(unsigned int timer_id, unsigned short wcet_us);
+void TimerService_UpdateWcetHint(unsigned int timer_id, unsigned short measured_us);
+
+/* 
+ * consistent copy of one slot, for diagnostic
+ * return 0  : copied
+ *        -1 : invalid id or slot not created
+ */
+int  TimerService_GetInfo(unsigned int timer_id, TIMER_INSTANCE_T *info);
+
+/* utilization of all created timers and current limit, in permille */
+unsigned long TimerService_GetUtilization(void);
+unsigned long TimerService_GetUtilizationLimit(void);
+
 /* 1 ms tick hook, must be called from 1ms Timer IRQ */
 void TimerService_Tick1ms(void);
 
-/* execute in main loop , proceed queue-based + flag-based callback */
+/* execute in main loop , proceed queue-based + deferred call + flag-based callback */
 void TimerService_Dispatch(void);
 
+/* 
+ * same as TimerService_Dispatch, but return after max_events callback (0 = no limit)
+ * remaining work resume round-robin on next call
+ * return number of executed callback
+ */
+unsigned int TimerService_DispatchBudget(unsigned int max_events);
+
 
 #endif //__TIMER_SERVICE_H__
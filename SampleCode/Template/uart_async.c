@@ -0,0 +1,459 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "uart_async.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define UART_ASYNC_DIR_TX                       (0U)
+#define UART_ASYNC_DIR_RX                       (1U)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile UART_ASYNC_XFER_T g_UartAsync[UART_ASYNC_PORT_NUM][2];
+
+static int g_UartAsyncTimerId = -1;
+static volatile unsigned char g_UartAsyncTimerRun = 0U;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define UART_ASYNC_ENTER_CRITICAL(m)            do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define UART_ASYNC_EXIT_CRITICAL(m)             __set_PRIMASK(m)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+static UART_T *UartAsync_GetUart(unsigned char port)
+{
+    if (port == UART_ASYNC_PORT_UART0)
+    {
+        return UART0;
+    }
+    if (port == UART_ASYNC_PORT_UART1)
+    {
+        return UART1;
+    }
+    return (UART_T *)0;
+}
+
+static UUART_T *UartAsync_GetUuart(unsigned char port)
+{
+    if (port == UART_ASYNC_PORT_UUART0)
+    {
+        return UUART0;
+    }
+    if (port == UART_ASYNC_PORT_UUART1)
+    {
+        return UUART1;
+    }
+    return (UUART_T *)0;
+}
+
+static IRQn_Type UartAsync_GetIrq(unsigned char port)
+{
+    if (port == UART_ASYNC_PORT_UART0)
+    {
+        return UART02_IRQn;
+    }
+    if (port == UART_ASYNC_PORT_UART1)
+    {
+        return UART13_IRQn;
+    }
+    return USCI01_IRQn;
+}
+
+/* stop transfer interrupt of one direction */
+static void UartAsync_DisableInt(unsigned char port, unsigned char dir)
+{
+    UART_T *uart;
+    UUART_T *uuart;
+
+    uart  = UartAsync_GetUart(port);
+    uuart = UartAsync_GetUuart(port);
+
+    if (uart != (UART_T *)0)
+    {
+        UART_DISABLE_INT(uart, (dir == UART_ASYNC_DIR_TX) ? UART_INTEN_THREIEN_Msk :
+                                                            (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk));
+    }
+    else
+    {
+        UUART_DISABLE_TRANS_INT(uuart, (dir == UART_ASYNC_DIR_TX) ? UUART_INTEN_TXENDIEN_Msk :
+                                                                    UUART_INTEN_RXENDIEN_Msk);
+    }
+}
+
+static void UartAsync_EnableInt(unsigned char port, unsigned char dir)
+{
+    UART_T *uart;
+    UUART_T *uuart;
+
+    uart  = UartAsync_GetUart(port);
+    uuart = UartAsync_GetUuart(port);
+
+    if (uart != (UART_T *)0)
+    {
+        UART_ENABLE_INT(uart, (dir == UART_ASYNC_DIR_TX) ? UART_INTEN_THREIEN_Msk :
+                                                           (UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk));
+    }
+    else
+    {
+        UUART_ENABLE_TRANS_INT(uuart, (dir == UART_ASYNC_DIR_TX) ? UUART_INTEN_TXENDIEN_Msk :
+                                                                   UUART_INTEN_RXENDIEN_Msk);
+    }
+
+    NVIC_EnableIRQ(UartAsync_GetIrq(port));
+}
+
+/* deferred completion , run in TimerService_Dispatch */
+static void UartAsync_Complete(void *user_data)
+{
+    volatile UART_ASYNC_XFER_T *x;
+    UART_ASYNC_CALLBACK_T cb;
+    void *user;
+    unsigned int count;
+    int status;
+
+    x = (volatile UART_ASYNC_XFER_T *)user_data;
+
+    cb     = x->callback;
+    user   = x->user_data;
+    count  = x->count;
+    status = x->status;
+
+    /* idle before callback : callback may start next transfer */
+    x->busy = UART_ASYNC_IDLE;
+
+    if (cb != (UART_ASYNC_CALLBACK_T)0)
+    {
+        cb(status, count, user);
+    }
+}
+
+/* ISR or critical section : interrupt already stopped */
+static void UartAsync_Finish(volatile UART_ASYNC_XFER_T *x, signed char status)
+{
+    x->status = status;
+
+    if (TimerService_Post(UartAsync_Complete, (void *)x) == 0)
+    {
+        x->busy = UART_ASYNC_DONE;
+    }
+    else
+    {
+        x->busy = UART_ASYNC_UNPOSTED;
+    }
+}
+
+/* move byte between FIFO and buffer , return 1 if all done */
+static int UartAsync_Pump(unsigned char port, volatile UART_ASYNC_XFER_T *x)
+{
+    UART_T *uart;
+    UUART_T *uuart;
+
+    uart  = UartAsync_GetUart(port);
+    uuart = UartAsync_GetUuart(port);
+
+    if (x->dir == UART_ASYNC_DIR_TX)
+    {
+        if (uart != (UART_T *)0)
+        {
+            while ((x->count < x->len) && (UART_IS_TX_FULL(uart) == 0))
+            {
+                UART_WRITE(uart, x->buf[x->count++]);
+            }
+        }
+        else
+        {
+            while ((x->count < x->len) && (UUART_IS_TX_FULL(uuart) == 0))
+            {
+                UUART_WRITE(uuart, x->buf[x->count++]);
+            }
+        }
+    }
+    else
+    {
+        if (uart != (UART_T *)0)
+        {
+            while ((x->count < x->len) && (UART_GET_RX_EMPTY(uart) == 0))
+            {
+                x->buf[x->count++] = (unsigned char)UART_READ(uart);
+            }
+        }
+        else
+        {
+            while ((x->count < x->len) && (UUART_IS_RX_EMPTY(uuart) == 0))
+            {
+                x->buf[x->count++] = (unsigned char)UUART_READ(uuart);
+            }
+        }
+    }
+
+    return (x->count >= x->len) ? 1 : 0;
+}
+
+static void UartAsync_Service(unsigned char port, unsigned char dir)
+{
+    volatile UART_ASYNC_XFER_T *x;
+
+    x = &g_UartAsync[port][dir];
+
+    if (x->busy != UART_ASYNC_RUN)
+    {
+        UartAsync_DisableInt(port, dir);
+        return;
+    }
+
+    if (UartAsync_Pump(port, x))
+    {
+        UartAsync_DisableInt(port, dir);
+        UartAsync_Finish(x, UART_ASYNC_OK);
+    }
+}
+
+void UartAsync_IRQHandler(unsigned char port)
+{
+    UART_T *uart;
+    UUART_T *uuart;
+
+    if (port >= UART_ASYNC_PORT_NUM)
+    {
+        return;
+    }
+
+    uart  = UartAsync_GetUart(port);
+    uuart = UartAsync_GetUuart(port);
+
+    if (uart != (UART_T *)0)
+    {
+        if ((uart->INTEN & UART_INTEN_THREIEN_Msk) && UART_GET_INT_FLAG(uart, UART_INTSTS_THREINT_Msk))
+        {
+            UartAsync_Service(port, UART_ASYNC_DIR_TX);
+        }
+
+        if ((uart->INTEN & UART_INTEN_RDAIEN_Msk) && UART_GET_INT_FLAG(uart, UART_INTSTS_RDAINT_Msk | UART_INTSTS_RXTOINT_Msk))
+        {
+            UartAsync_Service(port, UART_ASYNC_DIR_RX);
+        }
+
+        if (uart->FIFOSTS & (UART_FIFOSTS_BIF_Msk | UART_FIFOSTS_FEF_Msk | UART_FIFOSTS_PEF_Msk | UART_FIFOSTS_RXOVIF_Msk))
+        {
+            UART_ClearIntFlag(uart, (UART_INTSTS_RLSINT_Msk | UART_INTSTS_BUFERRINT_Msk));
+        }
+    }
+    else
+    {
+        if (UUART_GET_PROT_STATUS(uuart) & UUART_PROTSTS_TXENDIF_Msk)
+        {
+            UUART_CLR_PROT_INT_FLAG(uuart, UUART_PROTSTS_TXENDIF_Msk);
+            UartAsync_Service(port, UART_ASYNC_DIR_TX);
+        }
+
+        if (UUART_GET_PROT_STATUS(uuart) & UUART_PROTSTS_RXENDIF_Msk)
+        {
+            UUART_CLR_PROT_INT_FLAG(uuart, UUART_PROTSTS_RXENDIF_Msk);
+            UartAsync_Service(port, UART_ASYNC_DIR_RX);
+        }
+    }
+}
+
+/* timeout timer : expire deadline , deliver unposted callback , stop when nothing left */
+static void UartAsync_Poll(void *user_data)
+{
+    volatile UART_ASYNC_XFER_T *x;
+    unsigned long now;
+    unsigned char port;
+    unsigned char dir;
+    unsigned char active;
+    unsigned char expired;
+    uint32_t primask;
+
+    (void)user_data;
+
+    now    = TimerService_GetTick();
+    active = 0U;
+
+    for (port = 0U; port < UART_ASYNC_PORT_NUM; port++)
+    {
+        for (dir = 0U; dir < 2U; dir++)
+        {
+            x = &g_UartAsync[port][dir];
+            expired = 0U;
+
+            UART_ASYNC_ENTER_CRITICAL(primask);
+
+            if ((x->busy == UART_ASYNC_RUN) &&
+                (x->timeout_ms != 0U) &&
+                ((long)(now - x->deadline) >= 0L))
+            {
+                UartAsync_DisableInt(port, dir);
+                x->status = UART_ASYNC_TIMEOUT;
+                x->busy   = UART_ASYNC_DONE;
+                expired   = 1U;
+            }
+            else if (x->busy == UART_ASYNC_UNPOSTED)
+            {
+                x->busy = UART_ASYNC_DONE;
+                expired = 1U;
+            }
+
+            UART_ASYNC_EXIT_CRITICAL(primask);
+
+            if (expired)
+            {
+                UartAsync_Complete((void *)x);
+            }
+
+            if (x->busy != UART_ASYNC_IDLE)
+            {
+                active = 1U;
+            }
+        }
+    }
+
+    if ((active == 0U) && (g_UartAsyncTimerId >= 0))
+    {
+        TimerService_StopTimer((unsigned int)g_UartAsyncTimerId);
+        g_UartAsyncTimerRun = 0U;
+    }
+}
+
+static int UartAsync_Start(unsigned char port, unsigned char dir, unsigned char *buf, unsigned int len,
+                           unsigned short timeout_ms, UART_ASYNC_CALLBACK_T cb, void *user_data)
+{
+    volatile UART_ASYNC_XFER_T *x;
+    uint32_t primask;
+
+    if ((port >= UART_ASYNC_PORT_NUM) || (buf == (unsigned char *)0) || (len == 0U))
+    {
+        return -1;
+    }
+
+    #if !defined (UART_ASYNC_OWN_UART0)
+    /* interrupt enable of UART0 belong to printf / shell , its IRQ handler never call back here */
+    if (port == UART_ASYNC_PORT_UART0)
+    {
+        return -1;
+    }
+    #endif
+
+    x = &g_UartAsync[port][dir];
+
+    UART_ASYNC_ENTER_CRITICAL(primask);
+
+    if (x->busy != UART_ASYNC_IDLE)
+    {
+        UART_ASYNC_EXIT_CRITICAL(primask);
+        return -1;
+    }
+
+    x->buf        = buf;
+    x->len        = len;
+    x->count      = 0U;
+    x->timeout_ms = timeout_ms;
+    x->deadline   = TimerService_GetTick() + timeout_ms;
+    x->port       = port;
+    x->dir        = dir;
+    x->status     = UART_ASYNC_OK;
+    x->callback   = cb;
+    x->user_data  = user_data;
+    x->busy       = UART_ASYNC_RUN;
+
+    if (UartAsync_Pump(port, x))
+    {
+        UartAsync_Finish(x, UART_ASYNC_OK);     /* all fit in FIFO */
+    }
+    else
+    {
+        UartAsync_EnableInt(port, dir);
+    }
+
+    UART_ASYNC_EXIT_CRITICAL(primask);
+
+    if ((g_UartAsyncTimerRun == 0U) && (g_UartAsyncTimerId >= 0))
+    {
+        g_UartAsyncTimerRun = 1U;
+        TimerService_StartTimer((unsigned int)g_UartAsyncTimerId);
+    }
+
+    return 0;
+}
+
+int UART_WriteAsync(unsigned char port, const unsigned char *data, unsigned int len,
+                    unsigned short timeout_ms, UART_ASYNC_CALLBACK_T cb, void *user_data)
+{
+    /* TX never write into buf */
+    return UartAsync_Start(port, UART_ASYNC_DIR_TX, (unsigned char *)data, len, timeout_ms, cb, user_data);
+}
+
+int UART_ReadAsync(unsigned char port, unsigned char *buf, unsigned int len,
+                   unsigned short timeout_ms, UART_ASYNC_CALLBACK_T cb, void *user_data)
+{
+    return UartAsync_Start(port, UART_ASYNC_DIR_RX, buf, len, timeout_ms, cb, user_data);
+}
+
+void UART_CancelAsync(unsigned char port)
+{
+    volatile UART_ASYNC_XFER_T *x;
+    unsigned char dir;
+    unsigned char cancel;
+    uint32_t primask;
+
+    if (port >= UART_ASYNC_PORT_NUM)
+    {
+        return;
+    }
+
+    for (dir = 0U; dir < 2U; dir++)
+    {
+        x = &g_UartAsync[port][dir];
+        cancel = 0U;
+
+        UART_ASYNC_ENTER_CRITICAL(primask);
+
+        if (x->busy == UART_ASYNC_RUN)
+        {
+            UartAsync_DisableInt(port, dir);
+            x->status = UART_ASYNC_CANCEL;
+            x->busy   = UART_ASYNC_DONE;
+            cancel    = 1U;
+        }
+
+        UART_ASYNC_EXIT_CRITICAL(primask);
+
+        if (cancel)
+        {
+            UartAsync_Complete((void *)x);
+        }
+    }
+}
+
+int UART_IsAsyncBusy(unsigned char port)
+{
+    if (port >= UART_ASYNC_PORT_NUM)
+    {
+        return 0;
+    }
+
+    return ((g_UartAsync[port][UART_ASYNC_DIR_TX].busy != UART_ASYNC_IDLE) ||
+            (g_UartAsync[port][UART_ASYNC_DIR_RX].busy != UART_ASYNC_IDLE)) ? 1 : 0;
+}
+
+void UartAsync_Init(void)
+{
+    unsigned char port;
+    unsigned char dir;
+
+    for (port = 0U; port < UART_ASYNC_PORT_NUM; port++)
+    {
+        for (dir = 0U; dir < 2U; dir++)
+        {
+            g_UartAsync[port][dir].busy     = UART_ASYNC_IDLE;
+            g_UartAsync[port][dir].callback = (UART_ASYNC_CALLBACK_T)0;
+        }
+    }
+
+    /* created stopped , run only while a transfer is active */
+    g_UartAsyncTimerRun = 0U;
+    g_UartAsyncTimerId  = TimerService_CreateTimerQueue(UART_ASYNC_POLL_MS, UartAsync_Poll, (void *)0);
+}
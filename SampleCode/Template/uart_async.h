@@ -0,0 +1,89 @@
+#ifndef __UART_ASYNC_H__
+#define __UART_ASYNC_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * interrupt driven , non-blocking UART_Write / UART_Read
+ * port must be opened first (clock , pin , UART_Open / UUART_Open) , and its IRQ handler call UartAsync_IRQHandler
+ * template : UART1 only (UART13_IRQHandler) , USCI port need USCI01_IRQHandler from application
+ * UART0 own by debug printf ring and shell (THREIEN / RDAIEN) : rejected unless UART_ASYNC_OWN_UART0 is defined
+ * and UART02_IRQHandler forward to UartAsync_IRQHandler
+ */
+#define UART_ASYNC_PORT_UART0                   (0U)
+#define UART_ASYNC_PORT_UART1                   (1U)
+#define UART_ASYNC_PORT_UUART0                  (2U)
+#define UART_ASYNC_PORT_UUART1                  (3U)
+#define UART_ASYNC_PORT_NUM                     (4U)
+
+#define UART_ASYNC_POLL_MS                      (10U)     /* timeout resolution */
+
+/* transfer state */
+#define UART_ASYNC_IDLE                         (0U)
+#define UART_ASYNC_RUN                          (1U)
+#define UART_ASYNC_DONE                         (2U)      /* callback posted */
+#define UART_ASYNC_UNPOSTED                     (3U)      /* defer queue full , callback from timeout timer */
+
+/* completion status */
+#define UART_ASYNC_OK                           (0)
+#define UART_ASYNC_TIMEOUT                      (-1)      /* count < len */
+#define UART_ASYNC_CANCEL                       (-2)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+/* run in TimerService_Dispatch , never in ISR */
+typedef void (*UART_ASYNC_CALLBACK_T)(int status, unsigned int count, void *user_data);
+
+typedef struct _uart_async_xfer_t
+{
+    unsigned char          *buf;        /* caller buffer , must stay valid until callback */
+    unsigned int            len;
+    unsigned int            count;
+    unsigned long           deadline;   /* TimerService_GetTick based */
+    unsigned short          timeout_ms; /* 0 : no deadline */
+    unsigned char           busy;       /* UART_ASYNC_IDLE .. UART_ASYNC_UNPOSTED */
+    unsigned char           reserved;
+    unsigned char           port;
+    unsigned char           dir;
+    signed char             status;
+    UART_ASYNC_CALLBACK_T   callback;
+    void                   *user_data;
+
+} UART_ASYNC_XFER_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* create timeout timer , call after TimerService_Init */
+void UartAsync_Init(void);
+
+/*
+ * return immediately , cb(status, count, user_data) when all byte done or timeout
+ * TX complete : all byte in TX FIFO , last byte may still be on the line
+ * timeout_ms 0 : wait forever
+ * return 0  : started
+ *        -1 : invalid port / argument (UART0 without UART_ASYNC_OWN_UART0) , or same direction busy
+ */
+int  UART_WriteAsync(unsigned char port, const unsigned char *data, unsigned int len,
+                     unsigned short timeout_ms, UART_ASYNC_CALLBACK_T cb, void *user_data);
+
+int  UART_ReadAsync(unsigned char port, unsigned char *buf, unsigned int len,
+                    unsigned short timeout_ms, UART_ASYNC_CALLBACK_T cb, void *user_data);
+
+/* stop both direction , running transfer complete with UART_ASYNC_CANCEL */
+void UART_CancelAsync(unsigned char port);
+
+/* 1 : write or read running */
+int  UART_IsAsyncBusy(unsigned char port);
+
+/* call from UART / USCI IRQ handler */
+void UartAsync_IRQHandler(unsigned char port);
+
+#endif //__UART_ASYNC_H__
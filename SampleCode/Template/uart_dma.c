@@ -0,0 +1,297 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include <string.h>
+#include "NuMicro.h"
+
+#include "misc_config.h"
+#include "uart_dma.h"
+#include "pdma_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/* polled printf write UART_DMA_PORT->DAT with no way to hold it off */
+#if defined (ENABLE_UART_DMA_TX) && !defined (DEBUG_TX_IRQ)
+#error "ENABLE_UART_DMA_TX need DEBUG_TX_IRQ (retarget.c TX ring paused while a block is sent)"
+#endif
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile UART_DMA_TX_T g_UartDmaTx;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define UART_DMA_ENTER_CRITICAL(m)              do { (m) = __get_PRIMASK(); __disable_irq(); } while (0)
+#define UART_DMA_EXIT_CRITICAL(m)               __set_PRIMASK(m)
+
+/* printf ring share the port : hold it while a block is on PDMA */
+#if defined (DEBUG_TX_IRQ)
+#define UART_DMA_RING_PAUSE(cb)                 DebugTx_Pause(cb)
+#define UART_DMA_RING_RESUME()                  DebugTx_Resume()
+#else
+#define UART_DMA_RING_PAUSE(cb)                 (1)
+#define UART_DMA_RING_RESUME()
+#endif
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long UartDma_GetBlockCnt(void)
+{
+    return g_UartDmaTx.blockcnt;
+}
+
+unsigned long UartDma_GetByteCnt(void)
+{
+    return g_UartDmaTx.bytecnt;
+}
+
+unsigned long UartDma_GetAbortCnt(void)
+{
+    return g_UartDmaTx.abortcnt;
+}
+
+int UartDma_IsIdle(void)
+{
+    volatile UART_DMA_TX_T *t;
+    t = &g_UartDmaTx;
+
+    return ((t->sending == UART_DMA_BLOCK_NONE) &&
+            (t->state[0] == UART_DMA_BLOCK_FREE) &&
+            (t->state[1] == UART_DMA_BLOCK_FREE)) ? 1 : 0;
+}
+
+void UartDma_SetCallback(TIMER_CALLBACK_T cb, void *user_data)
+{
+    g_UartDmaTx.callback  = cb;
+    g_UartDmaTx.user_data = user_data;
+}
+
+/* program PDMA for sending block , printf ring already drained up to pause point */
+static void UartDma_Kick(void)
+{
+    volatile UART_DMA_TX_T *t;
+    unsigned char idx;
+
+    t = &g_UartDmaTx;
+
+    idx = t->sending;
+    if (idx == UART_DMA_BLOCK_NONE)
+    {
+        return;
+    }
+
+    PDMA->CHCTL |= (1UL << t->ch);
+    PDMA_SetTransferCnt(PDMA, t->ch, PDMA_WIDTH_8, t->len[idx]);
+    PDMA_SetTransferAddr(PDMA, t->ch,
+                         (uint32_t)&t->buf[idx][0], PDMA_SAR_INC,
+                         (uint32_t)&UART_DMA_PORT->DAT, PDMA_DAR_FIX);
+    PDMA_SetTransferMode(PDMA, t->ch, UART_DMA_TX_REQ, FALSE, 0);
+    PDMA_SetBurstType(PDMA, t->ch, PDMA_REQ_SINGLE, 0);
+
+    UART_DMA_PORT->INTEN |= UART_INTEN_TXPDMAEN_Msk;
+}
+
+/* UART IRQ , printf byte queued before the block are in FIFO */
+static void UartDma_RingDrained(void)
+{
+    UartDma_Kick();
+}
+
+/* block owned by PDMA , caller hold critical section or in PDMA IRQ */
+static void UartDma_StartBlock(unsigned char idx)
+{
+    volatile UART_DMA_TX_T *t;
+    t = &g_UartDmaTx;
+
+    t->state[idx] = UART_DMA_BLOCK_SENDING;
+    t->sending    = idx;
+
+    if (UART_DMA_RING_PAUSE(UartDma_RingDrained))
+    {
+        UartDma_Kick();
+    }
+}
+
+/* block full or flush : hand over to PDMA */
+static void UartDma_SealBlock(unsigned char idx)
+{
+    volatile UART_DMA_TX_T *t;
+    uint32_t primask;
+
+    t = &g_UartDmaTx;
+
+    UART_DMA_ENTER_CRITICAL(primask);
+
+    if (t->sending == UART_DMA_BLOCK_NONE)
+    {
+        UartDma_StartBlock(idx);
+    }
+    else
+    {
+        t->state[idx] = UART_DMA_BLOCK_QUEUED;
+    }
+
+    UART_DMA_EXIT_CRITICAL(primask);
+}
+
+/* PDMA IRQ : block sent , or lost on bus abort */
+static void UartDma_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    volatile UART_DMA_TX_T *t;
+    unsigned char done;
+    unsigned char next;
+
+    (void)ch;
+    (void)user_data;
+
+    t = &g_UartDmaTx;
+
+    done = t->sending;
+    if (done == UART_DMA_BLOCK_NONE)
+    {
+        return;
+    }
+
+    if (event & PDMA_SERVICE_EVT_ABORT)
+    {
+        t->abortcnt++;      /* block dropped , part of it may be on the wire */
+    }
+    else
+    {
+        t->blockcnt++;
+        t->bytecnt += t->len[done];
+    }
+
+    t->len[done]   = 0U;
+    t->state[done] = UART_DMA_BLOCK_FREE;
+
+    /* printf put while sending go first , next block pause the ring again */
+    UART_DMA_RING_RESUME();
+
+    next = (unsigned char)(done ^ 1U);
+    if (t->state[next] == UART_DMA_BLOCK_QUEUED)
+    {
+        UartDma_StartBlock(next);
+    }
+    else
+    {
+        t->sending = UART_DMA_BLOCK_NONE;
+        UART_DMA_PORT->INTEN &= ~UART_INTEN_TXPDMAEN_Msk;
+    }
+
+    if (t->callback != (TIMER_CALLBACK_T)0)
+    {
+        TimerService_Post(t->callback, t->user_data);
+    }
+}
+
+unsigned int UartDma_Write(const unsigned char *data, unsigned int len)
+{
+    volatile UART_DMA_TX_T *t;
+    unsigned int accepted;
+    unsigned int n;
+    unsigned char b;
+
+    t = &g_UartDmaTx;
+    accepted = 0U;
+
+    if (t->ch == UART_DMA_CH_NONE)
+    {
+        return 0U;
+    }
+
+    while (len > 0U)
+    {
+        b = t->fill;
+
+        if (t->state[b] == UART_DMA_BLOCK_FREE)
+        {
+            t->len[b]   = 0U;
+            t->state[b] = UART_DMA_BLOCK_FILLING;
+        }
+        else if (t->state[b] != UART_DMA_BLOCK_FILLING)
+        {
+            break;      /* both block busy */
+        }
+
+        n = UART_DMA_TX_BLOCK_SIZE - t->len[b];
+        if (n > len)
+        {
+            n = len;
+        }
+
+        memcpy((void *)&t->buf[b][t->len[b]], data, n);
+        t->len[b] = (unsigned short)(t->len[b] + n);
+
+        data     += n;
+        len      -= n;
+        accepted += n;
+
+        if (t->len[b] >= UART_DMA_TX_BLOCK_SIZE)
+        {
+            t->fill = (unsigned char)(b ^ 1U);
+            UartDma_SealBlock(b);
+        }
+    }
+
+    /* PDMA idle : send partial block now, keep latency low */
+    b = t->fill;
+    if ((t->sending == UART_DMA_BLOCK_NONE) &&
+        (t->state[b] == UART_DMA_BLOCK_FILLING) &&
+        (t->len[b] > 0U))
+    {
+        t->fill = (unsigned char)(b ^ 1U);
+        UartDma_SealBlock(b);
+    }
+
+    return accepted;
+}
+
+void UartDma_WriteAll(const unsigned char *data, unsigned int len)
+{
+    unsigned int n;
+
+    if (g_UartDmaTx.ch == UART_DMA_CH_NONE)
+    {
+        return;
+    }
+
+    while (len > 0U)
+    {
+        n = UartDma_Write(data, len);
+
+        data += n;
+        len  -= n;
+    }
+}
+
+void UartDma_Init(void)
+{
+    volatile UART_DMA_TX_T *t;
+    int ch;
+
+    t = &g_UartDmaTx;
+
+    t->len[0]    = 0U;
+    t->len[1]    = 0U;
+    t->state[0]  = UART_DMA_BLOCK_FREE;
+    t->state[1]  = UART_DMA_BLOCK_FREE;
+    t->fill      = 0U;
+    t->sending   = UART_DMA_BLOCK_NONE;
+    t->blockcnt  = 0UL;
+    t->bytecnt   = 0UL;
+    t->abortcnt  = 0UL;
+    t->callback  = (TIMER_CALLBACK_T)0;
+    t->user_data = (void *)0;
+    t->ch        = UART_DMA_CH_NONE;
+
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_ANY, UartDma_PdmaHook, (void *)0);
+    if (ch < 0)
+    {
+        return;     /* UartDma_Write accept nothing */
+    }
+
+    t->ch = (unsigned char)ch;
+
+    PDMA_Open(PDMA, 1UL << t->ch);
+    PDMA_EnableInt(PDMA, t->ch, PDMA_INT_TRANS_DONE);
+}
@@ -0,0 +1,69 @@
+#ifndef __UART_DMA_H__
+#define __UART_DMA_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define UART_DMA_PORT                           (UART0)   /* shared with printf ring (DEBUG_TX_IRQ) , ring paused while a block is sent */
+#define UART_DMA_TX_REQ                         (PDMA_UART0_TX)
+#define UART_DMA_TX_BLOCK_SIZE                  (256U)    /* one of two log blocks */
+
+/* tx block state */
+#define UART_DMA_BLOCK_FREE                     (0U)
+#define UART_DMA_BLOCK_FILLING                  (1U)      /* owned by UartDma_Write */
+#define UART_DMA_BLOCK_QUEUED                   (2U)      /* sealed, wait for PDMA */
+#define UART_DMA_BLOCK_SENDING                  (3U)      /* owned by PDMA */
+
+#define UART_DMA_BLOCK_NONE                     (0xFFU)
+#define UART_DMA_CH_NONE                        (0xFFU)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+typedef struct _uart_dma_tx_t
+{
+    unsigned char    buf[2][UART_DMA_TX_BLOCK_SIZE];
+    unsigned short   len[2];
+    unsigned char    state[2];
+    unsigned char    fill;          /* block written by UartDma_Write */
+    unsigned char    sending;       /* block on PDMA, UART_DMA_BLOCK_NONE if idle */
+    unsigned char    ch;            /* from PdmaService_AllocChannel */
+    unsigned long    blockcnt;      /* completed block */
+    unsigned long    bytecnt;       /* completed byte */
+    unsigned long    abortcnt;      /* block lost on PDMA abort , not in blockcnt / bytecnt */
+    TIMER_CALLBACK_T callback;      /* block complete, run in TimerService_Dispatch */
+    void            *user_data;
+
+} UART_DMA_TX_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after PdmaService_Init , take one PDMA channel */
+void UartDma_Init(void);
+
+/* completion callback for every transmitted block, deferred through TimerService_Post */
+void UartDma_SetCallback(TIMER_CALLBACK_T cb, void *user_data);
+
+/*
+ * main loop only, copy into log block and start PDMA if idle
+ * return number of byte accepted (less than len if both block are busy)
+ */
+unsigned int UartDma_Write(const unsigned char *data, unsigned int len);
+
+/* same as UartDma_Write, wait for free block until all accepted (interrupt must be enabled) */
+void UartDma_WriteAll(const unsigned char *data, unsigned int len);
+
+/* 1 : nothing pending or sending */
+int  UartDma_IsIdle(void);
+
+unsigned long UartDma_GetBlockCnt(void);
+unsigned long UartDma_GetByteCnt(void);
+unsigned long UartDma_GetAbortCnt(void);
+
+#endif //__UART_DMA_H__
@@ -0,0 +1,305 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "uart_dma_rx.h"
+#include "pdma_service.h"
+#include "pdma_sg.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#if ((UART_DMA_RX_BUF_SIZE & (UART_DMA_RX_BUF_SIZE - 1U)) != 0U)
+#error "UART_DMA_RX_BUF_SIZE must be power of 2"
+#endif
+
+#if ((UART_DMA_RX_FRAME_QUEUE & (UART_DMA_RX_FRAME_QUEUE - 1U)) != 0U)
+#error "UART_DMA_RX_FRAME_QUEUE must be power of 2"
+#endif
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile UART_DMA_RX_T g_UartDmaRx;
+
+/* descriptor in SRAM , A -> B -> A ... */
+static DSCT_T g_UartDmaRxDesc[2];
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define UART_DMA_RX_MASK                        (UART_DMA_RX_BUF_SIZE - 1U)
+#define UART_DMA_RX_FRAME_MASK                  (UART_DMA_RX_FRAME_QUEUE - 1U)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned long UartDmaRx_GetFrameCnt(void)
+{
+    return g_UartDmaRx.framecnt;
+}
+
+unsigned long UartDmaRx_GetDropCnt(void)
+{
+    return g_UartDmaRx.dropcnt;
+}
+
+unsigned long UartDmaRx_GetOverrunCnt(void)
+{
+    return g_UartDmaRx.overruncnt;
+}
+
+void UartDmaRx_Rearm(void)
+{
+    g_UartDmaRx.posted = 0U;
+}
+
+int UartDmaRx_GetFrame(UART_DMA_RX_VIEW_T *view)
+{
+    volatile UART_DMA_RX_T *r;
+    volatile UART_DMA_RX_FRAME_T *f;
+    unsigned int idx;
+    unsigned int len;
+
+    r = &g_UartDmaRx;
+
+    if (r->ftail == r->fhead)
+    {
+        return -1;
+    }
+
+    f   = &r->frame[r->ftail & UART_DMA_RX_FRAME_MASK];
+    idx = (unsigned int)(f->start & UART_DMA_RX_MASK);
+    len = f->len;
+
+    view->data0 = (const unsigned char *)&r->buf[idx];
+    view->flags = f->flags;
+
+    if ((idx + len) > UART_DMA_RX_BUF_SIZE)
+    {
+        view->len0  = UART_DMA_RX_BUF_SIZE - idx;
+        view->data1 = (const unsigned char *)&r->buf[0];
+        view->len1  = len - view->len0;
+    }
+    else
+    {
+        view->len0  = len;
+        view->data1 = (const unsigned char *)0;
+        view->len1  = 0U;
+    }
+
+    return 0;
+}
+
+void UartDmaRx_ReleaseFrame(void)
+{
+    volatile UART_DMA_RX_T *r;
+    volatile UART_DMA_RX_FRAME_T *f;
+
+    r = &g_UartDmaRx;
+
+    if (r->ftail == r->fhead)
+    {
+        return;
+    }
+
+    f = &r->frame[r->ftail & UART_DMA_RX_FRAME_MASK];
+
+    r->releasepos = f->start + f->len;
+    r->ftail++;
+}
+
+/* ISR context : queue [framepos , pos) as one frame */
+static void UartDmaRx_CloseFrame(unsigned long pos, unsigned char flags)
+{
+    volatile UART_DMA_RX_T *r;
+    volatile UART_DMA_RX_FRAME_T *f;
+    unsigned long start;
+    unsigned long len;
+
+    r = &g_UartDmaRx;
+
+    start = r->framepos;
+    len   = pos - start;
+
+    if (len == 0UL)
+    {
+        return;
+    }
+
+    r->framepos = pos;
+
+    /* PDMA already wrote over data not yet released */
+    if ((pos - r->releasepos) > UART_DMA_RX_BUF_SIZE)
+    {
+        r->overruncnt++;
+        flags |= UART_DMA_RX_FRAME_OVERRUN;
+
+        if (len > UART_DMA_RX_BUF_SIZE)
+        {
+            start = pos - UART_DMA_RX_BUF_SIZE;
+            len   = UART_DMA_RX_BUF_SIZE;
+        }
+    }
+
+    if ((unsigned char)(r->fhead - r->ftail) >= UART_DMA_RX_FRAME_QUEUE)
+    {
+        r->dropcnt++;
+        return;
+    }
+
+    f = &r->frame[r->fhead & UART_DMA_RX_FRAME_MASK];
+    f->start = start;
+    f->len   = (unsigned short)len;
+    f->flags = flags;
+    r->fhead++;
+    r->framecnt++;
+
+    if ((r->posted == 0U) && (r->consumer != (TIMER_CALLBACK_T)0))
+    {
+        if (TimerService_Post(r->consumer, r->user_data) == 0)
+        {
+            r->posted = 1U;
+        }
+    }
+}
+
+/* PDMA channel table done (one half filled) */
+static void UartDmaRx_HalfDoneFromISR(void)
+{
+    volatile UART_DMA_RX_T *r;
+    r = &g_UartDmaRx;
+
+    r->donebytes += UART_DMA_RX_HALF;
+
+    /* long stream without idle : hand over every half buffer */
+    if ((r->donebytes - r->framepos) >= UART_DMA_RX_HALF)
+    {
+        UartDmaRx_CloseFrame(r->donebytes, UART_DMA_RX_FRAME_PARTIAL);
+    }
+}
+
+int UartDmaRx_WakeFromISR(void)
+{
+    volatile UART_DMA_RX_T *r;
+    r = &g_UartDmaRx;
+
+    if (r->parked == 0U)
+    {
+        return 0;
+    }
+
+    r->parked = 0U;
+
+    /* FIFO not empty : PDMA request at once , idle count start again */
+    UART_DMA_RX_PORT->INTEN = (UART_DMA_RX_PORT->INTEN & ~(UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk)) |
+                              UART_INTEN_RXPDMAEN_Msk;
+    PDMA->TOUTEN |= (1UL << r->ch);
+
+    return 1;
+}
+
+/* PDMA request timeout , line idle */
+static void UartDmaRx_IdleFromISR(unsigned char ch)
+{
+    unsigned long txcnt;
+    unsigned long pos;
+
+    /* half done not yet serviced : count it first, TXCNT already belong to next table */
+    if (PDMA_GET_TD_STS(PDMA) & (1UL << ch))
+    {
+        PDMA_CLR_TD_FLAG(PDMA, 1UL << ch);
+        UartDmaRx_HalfDoneFromISR();
+    }
+
+    /* line idle : PDMA not moving , TXCNT is remaining - 1 of current table */
+    txcnt = (PDMA->DSCT[ch].CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos;
+    pos   = g_UartDmaRx.donebytes + ((UART_DMA_RX_HALF - 1UL) - txcnt);
+
+    UartDmaRx_CloseFrame(pos, UART_DMA_RX_FRAME_IDLE);
+
+    /* park : no timeout while nothing arrive , first byte raise UART RDA (or RX timeout , FIFO level set by uart_rx.c) */
+    g_UartDmaRx.parked = 1U;    /* before RDA enable : UART IRQ must see it */
+    PDMA->TOUTEN &= ~(1UL << ch);
+    UART_DMA_RX_PORT->INTEN = (UART_DMA_RX_PORT->INTEN & ~UART_INTEN_RXPDMAEN_Msk) |
+                              UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk;
+
+    /* PDMA took a byte after TXCNT read : it would wait unclosed until next traffic , keep timeout running */
+    if (((PDMA->DSCT[ch].CTL & PDMA_DSCT_CTL_TXCNT_Msk) >> PDMA_DSCT_CTL_TXCNT_Pos) != txcnt)
+    {
+        (void)UartDmaRx_WakeFromISR();
+    }
+}
+
+/* PDMA IRQ , done before timeout : half done counted first */
+static void UartDmaRx_PdmaHook(unsigned char ch, unsigned char event, void *user_data)
+{
+    (void)user_data;
+
+    if (event & PDMA_SERVICE_EVT_DONE)
+    {
+        UartDmaRx_HalfDoneFromISR();
+    }
+
+    if (event & PDMA_SERVICE_EVT_TIMEOUT)
+    {
+        UartDmaRx_IdleFromISR(ch);
+    }
+}
+
+/* A -> B -> A ... , done interrupt on each half */
+static void UartDmaRx_BuildRing(void)
+{
+    PDMA_SG_CHAIN_T chain;
+    unsigned char idx;
+
+    (void)PdmaSg_Init(&chain, g_UartDmaRxDesc, 2U, PDMA_SG_INT_EACH);
+
+    for (idx = 0U; idx < 2U; idx++)
+    {
+        (void)PdmaSg_Add(&chain, (uint32_t)&UART_DMA_RX_PORT->DAT,
+                         (uint32_t)&g_UartDmaRx.buf[idx * UART_DMA_RX_HALF], UART_DMA_RX_HALF,
+                         PDMA_WIDTH_8 | PDMA_SAR_FIX | PDMA_DAR_INC | PDMA_REQ_SINGLE);
+    }
+
+    (void)PdmaSg_MakeRing(&chain);
+}
+
+void UartDmaRx_Init(TIMER_CALLBACK_T consumer, void *user_data)
+{
+    volatile UART_DMA_RX_T *r;
+    int ch;
+
+    r = &g_UartDmaRx;
+
+    r->fhead      = 0U;
+    r->ftail      = 0U;
+    r->posted     = 0U;
+    r->ch         = UART_DMA_RX_CH_NONE;
+    r->parked     = 0U;
+    r->donebytes  = 0UL;
+    r->framepos   = 0UL;
+    r->releasepos = 0UL;
+    r->framecnt   = 0UL;
+    r->dropcnt    = 0UL;
+    r->overruncnt = 0UL;
+    r->consumer   = consumer;
+    r->user_data  = user_data;
+
+    /* request timeout exist on channel 0 / 1 only */
+    ch = PdmaService_AllocChannel(PDMA_SERVICE_ALLOC_HW_TIMEOUT, UartDmaRx_PdmaHook, (void *)0);
+    if (ch < 0)
+    {
+        return;     /* UART keep RDA interrupt */
+    }
+
+    r->ch = (unsigned char)ch;
+
+    UartDmaRx_BuildRing();
+
+    PDMA_Open(PDMA, 1UL << r->ch);
+    PDMA_SetTransferMode(PDMA, r->ch, UART_DMA_RX_REQ, TRUE, (uint32_t)&g_UartDmaRxDesc[0]);
+    PDMA_EnableInt(PDMA, r->ch, PDMA_INT_TRANS_DONE);
+    PDMA_SetTimeOut(PDMA, r->ch, TRUE, PdmaService_TimeoutCnt(UART_DMA_RX_IDLE_MS));
+    PDMA_EnableInt(PDMA, r->ch, PDMA_INT_TIMEOUT);
+
+    /* byte go to PDMA , frame end from PDMA request timeout , UART RX interrupt not used */
+    UART_DisableInt(UART_DMA_RX_PORT, UART_INTEN_RDAIEN_Msk | UART_INTEN_RXTOIEN_Msk);
+    UART_DMA_RX_PORT->INTEN |= UART_INTEN_RXPDMAEN_Msk;
+}
@@ -0,0 +1,105 @@
+#ifndef __UART_DMA_RX_H__
+#define __UART_DMA_RX_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+/*
+ * PDMA circular receive : two scatter-gather descriptor , each one half of buffer , linked to each other
+ * frame end : PDMA request timeout (line idle) , or one half buffer filled without idle (PARTIAL)
+ *             UART RXTOIF is cleared when RX FIFO is empty , PDMA empty it after every byte so UART RX timeout
+ *             never latch : channel 0 / 1 (PDMA_SERVICE_ALLOC_HW_TIMEOUT) and its request timeout are used instead
+ * idle    : after the timeout RX is parked : PDMA timeout off , RXPDMAEN off , UART RDA / RX timeout interrupt on
+ *           first byte wait in FIFO , UartDmaRx_WakeFromISR (UART IRQ) hand RX back to PDMA and re-arm the timeout
+ * PDMA never stop , consumer must release frame before it is overwritten (OVERRUN)
+ */
+#define UART_DMA_RX_PORT                        (UART0)
+#define UART_DMA_RX_REQ                         (PDMA_UART0_RX)
+#define UART_DMA_RX_BUF_SIZE                    (512U)    /* must be power of 2 */
+#define UART_DMA_RX_HALF                        (UART_DMA_RX_BUF_SIZE / 2U)
+#define UART_DMA_RX_FRAME_QUEUE                 (8U)      /* must be power of 2 */
+#define UART_DMA_RX_IDLE_MS                     (2U)      /* no byte for this long = frame end , PDMA timeout tick HCLK / 2^15 */
+
+/* frame flag */
+#define UART_DMA_RX_FRAME_IDLE                  (0x01U)   /* closed by line idle */
+#define UART_DMA_RX_FRAME_PARTIAL               (0x02U)   /* closed by half buffer , more data follow */
+#define UART_DMA_RX_FRAME_OVERRUN               (0x04U)   /* part of data overwritten before release */
+
+#define UART_DMA_RX_CH_NONE                     (0xFFU)
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+typedef struct _uart_dma_rx_frame_t
+{
+    unsigned long    start;         /* free running byte position */
+    unsigned short   len;
+    unsigned char    flags;
+    unsigned char    reserved;
+
+} UART_DMA_RX_FRAME_T;
+
+/* zero-copy view , frame may wrap at end of buffer : data0 then data1 */
+typedef struct _uart_dma_rx_view_t
+{
+    const unsigned char *data0;
+    unsigned int         len0;
+    const unsigned char *data1;
+    unsigned int         len1;
+    unsigned char        flags;
+
+} UART_DMA_RX_VIEW_T;
+
+typedef struct _uart_dma_rx_t
+{
+    unsigned char        buf[UART_DMA_RX_BUF_SIZE];
+    UART_DMA_RX_FRAME_T  frame[UART_DMA_RX_FRAME_QUEUE];
+    unsigned char        fhead;         /* free running , written by ISR */
+    unsigned char        ftail;         /* free running , written by UartDmaRx_ReleaseFrame */
+    unsigned char        posted;
+    unsigned char        ch;            /* from PdmaService_AllocChannel */
+    unsigned char        parked;        /* line idle , RX on UART interrupt until first byte */
+    unsigned long        donebytes;     /* completed half buffer x UART_DMA_RX_HALF */
+    unsigned long        framepos;      /* end of last closed frame */
+    unsigned long        releasepos;    /* end of last released frame */
+    unsigned long        framecnt;
+    unsigned long        dropcnt;       /* frame queue full */
+    unsigned long        overruncnt;
+    TIMER_CALLBACK_T     consumer;      /* posted through TimerService_Post when frame arrive */
+    void                *user_data;
+
+} UART_DMA_RX_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* call after PdmaService_Init and UART_Open , take PDMA channel 0 or 1 , RDA / RX timeout interrupt disabled */
+void UartDmaRx_Init(TIMER_CALLBACK_T consumer, void *user_data);
+
+/*
+ * UART RDA / RX timeout interrupt , before any other RX handling
+ * return 1 : parked RX handed back to PDMA (byte left in FIFO) , 0 : not parked
+ */
+int  UartDmaRx_WakeFromISR(void);
+
+/* consumer must call first, before reading frame , new frame will post again */
+void UartDmaRx_Rearm(void);
+
+/*
+ * main loop only , oldest frame without copy , stay valid until UartDmaRx_ReleaseFrame
+ * return 0  : view valid
+ *        -1 : no frame
+ */
+int  UartDmaRx_GetFrame(UART_DMA_RX_VIEW_T *view);
+void UartDmaRx_ReleaseFrame(void);
+
+unsigned long UartDmaRx_GetFrameCnt(void);
+unsigned long UartDmaRx_GetDropCnt(void);
+unsigned long UartDmaRx_GetOverrunCnt(void);
+
+#endif //__UART_DMA_RX_H__
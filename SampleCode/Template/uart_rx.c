@@ -0,0 +1,120 @@
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "uart_rx.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#if ((UART_RX_BUF_SIZE & (UART_RX_BUF_SIZE - 1U)) != 0U)
+#error "UART_RX_BUF_SIZE must be power of 2"
+#endif
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+volatile UART_RX_T g_UartRx;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+#define UART_RX_MASK                            (UART_RX_BUF_SIZE - 1U)
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+unsigned int UartRx_GetCount(void)
+{
+    return (unsigned short)(g_UartRx.head - g_UartRx.tail);
+}
+
+unsigned long UartRx_GetOverflowCnt(void)
+{
+    return g_UartRx.overflowcnt;
+}
+
+unsigned int UartRx_GetMaxUsed(void)
+{
+    return g_UartRx.maxused;
+}
+
+void UartRx_Rearm(void)
+{
+    g_UartRx.posted = 0U;
+}
+
+void UartRx_IRQHandler(void)
+{
+    volatile UART_RX_T *r;
+    unsigned short head;
+    unsigned short used;
+
+    r = &g_UartRx;
+    head = r->head;
+
+    while (UART_GET_RX_EMPTY(UART_RX_PORT) == 0)
+    {
+        if ((unsigned short)(head - r->tail) >= UART_RX_BUF_SIZE)
+        {
+            (void)UART_READ(UART_RX_PORT);      /* ring full : drop , keep FIFO moving */
+            r->overflowcnt++;
+            continue;
+        }
+
+        r->buf[head & UART_RX_MASK] = (unsigned char)UART_READ(UART_RX_PORT);
+        head++;
+    }
+
+    r->head = head;
+
+    used = (unsigned short)(head - r->tail);
+    if (used > r->maxused)
+    {
+        r->maxused = used;
+    }
+
+    /* one consumer event per batch , retry on next irq if defer queue full */
+    if ((used > 0U) && (r->posted == 0U) && (r->consumer != (TIMER_CALLBACK_T)0))
+    {
+        if (TimerService_Post(r->consumer, r->user_data) == 0)
+        {
+            r->posted = 1U;
+        }
+    }
+}
+
+unsigned int UartRx_Read(unsigned char *data, unsigned int len)
+{
+    volatile UART_RX_T *r;
+    unsigned short tail;
+    unsigned int n;
+
+    r = &g_UartRx;
+    tail = r->tail;
+    n = 0U;
+
+    while ((n < len) && (tail != r->head))
+    {
+        data[n++] = r->buf[tail & UART_RX_MASK];
+        tail++;
+    }
+
+    r->tail = tail;
+
+    return n;
+}
+
+void UartRx_Init(TIMER_CALLBACK_T consumer, void *user_data)
+{
+    volatile UART_RX_T *r;
+    r = &g_UartRx;
+
+    r->head        = 0U;
+    r->tail        = 0U;
+    r->maxused     = 0U;
+    r->posted      = 0U;
+    r->overflowcnt = 0UL;
+    r->consumer    = consumer;
+    r->user_data   = user_data;
+
+    /* interrupt per 8 byte , RXTOINT pick up the remainder after line idle */
+    UART_RX_PORT->FIFO = (UART_RX_PORT->FIFO & ~UART_FIFO_RFITL_Msk) | UART_RX_FIFO_LEVEL;
+    UART_SetTimeoutCnt(UART_RX_PORT, UART_RX_TIMEOUT_BIT);
+}
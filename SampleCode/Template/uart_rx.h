@@ -0,0 +1,55 @@
+#ifndef __UART_RX_H__
+#define __UART_RX_H__
+
+/*_____ I N C L U D E S ____________________________________________________*/
+#include <stdio.h>
+#include "NuMicro.h"
+
+#include "timer_service.h"
+
+/*_____ D E C L A R A T I O N S ____________________________________________*/
+
+#define UART_RX_PORT                            (UART0)
+#define UART_RX_BUF_SIZE                        (128U)    /* must be power of 2 */
+#define UART_RX_FIFO_LEVEL                      (UART_FIFO_RFITL_8BYTES)
+#define UART_RX_TIMEOUT_BIT                     (40U)     /* idle bit time before RXTOINT , flush FIFO remainder */
+
+/*_____ D E F I N I T I O N S ______________________________________________*/
+
+typedef struct _uart_rx_t
+{
+    unsigned char    buf[UART_RX_BUF_SIZE];
+    unsigned short   head;          /* free running , written by UartRx_IRQHandler */
+    unsigned short   tail;          /* free running , written by UartRx_Read */
+    unsigned short   maxused;
+    unsigned char    posted;        /* consumer already posted , not yet run */
+    unsigned long    overflowcnt;   /* byte dropped , ring full */
+    TIMER_CALLBACK_T consumer;      /* posted through TimerService_Post when data arrive */
+    void            *user_data;
+
+} UART_RX_T;
+
+/*_____ M A C R O S ________________________________________________________*/
+
+/*_____ F U N C T I O N S __________________________________________________*/
+
+/* set FIFO trigger level + RX timeout , call after UART_Open */
+void UartRx_Init(TIMER_CALLBACK_T consumer, void *user_data);
+
+/* RDAINT / RXTOINT : copy FIFO into ring , post consumer once per batch */
+void UartRx_IRQHandler(void);
+
+/*
+ * main loop only
+ * return number of byte copied into data (0 if ring empty)
+ */
+unsigned int UartRx_Read(unsigned char *data, unsigned int len);
+
+/* consumer must call first, before reading the ring , new data will post again */
+void UartRx_Rearm(void);
+
+unsigned int  UartRx_GetCount(void);
+unsigned long UartRx_GetOverflowCnt(void);
+unsigned int  UartRx_GetMaxUsed(void);
+
+#endif //__UART_RX_H__